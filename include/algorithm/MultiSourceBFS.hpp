@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CsrGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 单个根的 BFS 层宽剖面：widths[d] 为与根距离恰为 d 的节点数（widths[0] == 1）
+struct LevelProfile {
+    Index root = 0;
+    std::vector<std::size_t> widths;
+
+    std::size_t eccentricity() const { return widths.empty() ? 0 : widths.size() - 1; }
+    std::size_t reached() const;
+
+    // BFS 队列峰值（Metrics::measureBFSMaxQueue 的口径）的上下界：
+    // 第 d+1 层刚好全部入队、第 d 层全部出队时队列恰为 widths[d+1]，故峰值 >= max widths；
+    // 队列任何时刻都只含第 d 层的剩余部分与第 d+1 层的前缀，且处理第 d 层节点时该节点已出队，
+    // 故峰值 <= max(widths[d], widths[d] - 1 + widths[d+1])。
+    std::size_t peakLowerBound() const;
+    std::size_t peakUpperBound() const;
+};
+
+// 位并行多源 BFS：一次遍历同时推进 LANES 个根，每个节点用一个 64 位字记录
+// “哪些根已到达它”（seen）与“哪些根的当前边界包含它”（frontier）。
+// 每层只扫描边界非空的节点，一个批次的总工作量约等于一次普通 BFS 的 64 倍以内，
+// 但每条边一次处理 64 个根，因此全根层宽剖面的代价约为逐根 BFS 的 1/64。
+// 沿出边推进，有向图同样适用。
+class MultiSourceBFS {
+public:
+    static constexpr std::size_t LANES = 64;
+
+    // 计算给定根的层宽剖面，结果与 roots 一一对应；批次（每批 LANES 个根）在线程池上并行
+    static std::vector<LevelProfile> levelProfiles(const CsrGraph& graph, const std::vector<Index>& roots);
+
+    // 全部 n 个根
+    static std::vector<LevelProfile> allLevelProfiles(const CsrGraph& graph);
+};
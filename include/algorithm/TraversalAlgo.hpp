@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Graph.hpp"
+#include "BitAdjacency.hpp"
+#include "CsrGraph.hpp"
+#include "Constants.hpp"
+#include <cstddef>
+#include <string>
 #include <vector>
 
 // - order : 节点的访问顺序
@@ -10,6 +15,52 @@ struct TraversalTrace {
     std::vector<Index> parent;
 };
 
+// 有界内存遍历的代价统计
+// - peak      : 边界（栈 / 队列）的最大元素数
+// - expansions: 扫描邻接表的总次数；标准遍历恰为可达节点数，超出部分即换取内存上界所付出的额外工作
+// - rounds    : IDDFS 的迭代轮数 / 限队列 BFS 的重扫轮数（含首轮）
+// - auxiliary : 边界之外随 n 增长的辅助结构元素数（IDDFS 的逐轮深度表为 n），不含所有遍历共有的 visited
+struct TraversalCost {
+    std::size_t peak = 0;
+    std::size_t expansions = 0;
+    std::size_t rounds = 0;
+    std::size_t auxiliary = 0;
+};
+
+// 压缩边界 BFS 的占用统计
+// - peakElements: 逻辑峰值（当前层剩余 + 下一层已发现），即普通 BFS 队列口径的元素数
+// - peakBytes   : 边界容器实际占用字节数的峰值（id 列表按 capacity 计，位图按字数计）
+// - bitmapLevels: 以位图形式存储过的层数
+struct FrontierStats {
+    std::size_t peakElements = 0;
+    std::size_t peakBytes = 0;
+    std::size_t bitmapLevels = 0;
+};
+
+// 外存 BFS 的配置
+// - tempDir   : 层文件（当前层 / 下一层）所在目录，结束后删除
+// - blockBytes: 层文件顺序读写的块大小
+// - keepTrace : true 时在内存中保留 order / parent（两个 n 级数组）；默认 false 返回空轨迹，
+//               只保留 n/8 字节的 visited 位图，访问序可通过 orderPath 流式写出
+// - orderPath : 非空时把访问序按块顺序写入该文件（与 Index 数组同格式）
+struct ExternalBfsOptions {
+    std::string tempDir = ".";
+    std::size_t blockBytes = EXTERNAL_BLOCK_BYTES;
+    bool keepTrace = false;
+    std::string orderPath;
+};
+
+// 外存 BFS 的 I/O 统计（字节数与块数均含 orderPath 的写出）
+struct ExternalIoStats {
+    std::size_t bytesWritten = 0;
+    std::size_t bytesRead = 0;
+    std::size_t blocksWritten = 0;
+    std::size_t blocksRead = 0;
+    std::size_t levels = 0;
+    std::size_t peakLevelSize = 0; // 单层最大节点数（即落盘的边界规模）
+    std::size_t visitedCount = 0;
+};
+
 class TraversalAlgo {
 public:
     // 兼容原接口：只遍历，不返回轨迹（内部调用 Trace 版本丢弃结果）
@@ -19,4 +70,39 @@ public:
     // 新接口：返回遍历轨迹（用于 Metrics 的结构指标测量）
     static TraversalTrace bfsTrace(Graph& graph);
     static TraversalTrace dfsTrace(Graph& graph);
+
+    // 位并行版本：用 adjRow & ~visited 一次筛出 64 个（AVX2 下 256 个）未访问邻居，
+    // 再按 ctz 升序取出。邻居按升序排列时（如 AdjMatrixGraph），访问序与 bfsTrace / dfsTrace 完全一致。
+    static TraversalTrace bfsTraceBitset(const BitAdjacency& adj);
+    static TraversalTrace dfsTraceBitset(const BitAdjacency& adj);
+
+    // 预取流水线 BFS（扁平布局）：处理队列第 i 个节点时，预取第 i+distance 个节点的邻接区间
+    // 以及第 i+2*distance 个节点的 offsets 项。distance == 0 时退化为不预取的普通 BFS。
+    static TraversalTrace bfsTracePrefetch(const CsrGraph& graph,
+                                           std::size_t distance = PREFETCH_DISTANCE);
+
+    // 迭代加深 DFS：深度上限 L = 0, 1, 2, ... 逐轮做深度受限的 Path-DFS，
+    // 节点仅在以更短深度到达时才被重新展开。路径栈峰值为 root 的离心率 + 1，与邻居顺序无关。
+    // “更短深度”需要一张每轮重置的深度表（n 个 int，记入 cost->auxiliary）；不用它的经典 IDDFS
+    // 在稠密图上要枚举全部简单路径，代价为指数级。每次展开只取一次邻居（每次 getNeighbors 计一次 expansions）。
+    // order 按首次发现记录，因此按层输出；parent 为一棵最短路树。
+    static TraversalTrace iddfsTrace(Graph& graph, Index root = ROOT, TraversalCost* cost = nullptr);
+
+    // 限队列 BFS：队列元素数始终不超过 budget（至少为 1）。队列满时暂不入队，
+    // 待队列清空后按发现顺序重扫已访问节点，把仍有未访问邻居的节点重新入队（以重算代替溢出存储）。
+    // order 按发现顺序记录；budget 足够大时与 bfsTrace 完全一致。
+    static TraversalTrace cappedBfsTrace(Graph& graph, std::size_t budget,
+                                         Index root = ROOT, TraversalCost* cost = nullptr);
+
+    // 压缩边界 BFS：按层推进，每一层的边界在 id 列表与 n 位位图之间自动切换——
+    // 当 元素数 * sizeof(Index) 超过位图字节数时转为位图。位图层按 id 升序出队，
+    // 其余层按发现顺序出队；从未切换为位图时访问序与 bfsTrace 完全一致。
+    static TraversalTrace bfsTraceCompressed(Graph& graph, FrontierStats* stats = nullptr);
+
+    // 外存 BFS：边界按层写入临时文件，以 blockBytes 为单位顺序读写；visited 为内存中的 n 位位图。
+    // 与 mapFile() 得到的内存映射 CsrGraph 配合，图本身也不必载入内存。
+    // 层文件按发现顺序写出、按顺序读回，因此访问序与 bfsTrace 完全一致。I/O 失败时抛出 std::runtime_error。
+    static TraversalTrace bfsTraceExternal(const CsrGraph& graph,
+                                           const ExternalBfsOptions& options = ExternalBfsOptions(),
+                                           ExternalIoStats* io = nullptr);
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "Constants.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// 拉取式（pull-based）遍历游标：每次 next() 只推进到下一个被访问的节点，
+// 不物化完整的 order / label 序列。调用方可在任意时刻停止（例如与参考访问秩比对时遇到首个不一致）。
+// 除 visited 位图外，额外内存只有当前边界：BFS 为队列，Path-DFS 为当前路径。
+
+// BFS 游标：产出顺序与 Metrics::measureBFSMaxQueueFromRoot 的 order 一致（出队顺序）
+class BFSCursor {
+public:
+    explicit BFSCursor(const Graph& graph, Index root = ROOT);
+
+    // 取出下一个节点；遍历结束返回 false
+    bool next(Index& out);
+
+    // 截至目前的队列峰值；完整走完时与 measureBFSMaxQueueFromRoot 的返回值相同
+    std::size_t peak() const { return maxSize; }
+    std::size_t frontierSize() const { return qu.size(); }
+
+private:
+    const Graph& graph;
+    int n = 0;
+    std::deque<Index> qu;
+    std::vector<std::uint8_t> visited;
+    std::size_t maxSize = 0;
+};
+
+// Path-DFS 游标：产出顺序与 Metrics::measureDFSMaxStackFromRoot 的 order 一致（发现顺序 / preorder）
+class PathDFSCursor {
+public:
+    explicit PathDFSCursor(const Graph& graph, Index root = ROOT);
+
+    bool next(Index& out);
+
+    // 截至目前的路径栈峰值；完整走完时与 measureDFSMaxStackFromRoot 的返回值相同
+    std::size_t peak() const { return maxSize; }
+    std::size_t frontierSize() const { return st.size(); }
+
+private:
+    const Graph& graph;
+    int n = 0;
+    Index root = ROOT;
+    bool started = false;
+    // (节点, 下一个待检查的邻居下标)：只保存当前路径，代替全图大小的 nextIdx 数组
+    std::vector<std::pair<Index, std::size_t>> st;
+    std::vector<std::uint8_t> visited;
+    std::size_t maxSize = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <vector>
+
+// 森林（无向无环图）上的换根动态规划。
+// 邻接以 adj[u] = u 的邻居列表给出（即 Graph::getNeighbors 的快照），节点 id 为 0..n-1。
+class TreeRerooting {
+public:
+    // 是否为森林：邻接对称、无自环、无重边、无越界 id，且无向边数 = n - 连通分量数。O(n + m)
+    static bool isForest(const std::vector<std::vector<Index>>& adj);
+
+    // 每个节点在其所在树中的离心率（到最远节点的边数）。
+    // 先任取一点为根自底向上求 down（子树内最远），再自顶向下求 up（经父节点最远），
+    // ecc[u] = max(down[u], up[u])。O(n)，全程迭代实现，长链也不会爆栈。要求 isForest(adj)。
+    static std::vector<std::size_t> eccentricities(const std::vector<std::vector<Index>>& adj);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <vector>
+
+// 按位存储的邻接矩阵快照（只读）：第 u 行的第 v 位为 1 表示存在边 u -> v。
+// 每行的字数补齐到 4 的倍数，使 AVX2 路径一次处理 256 个候选而无需尾部处理。
+// 行内按位升序枚举邻居，与 AdjMatrixGraph::getNeighbors 的升序邻居顺序一致。
+class BitAdjacency {
+public:
+    BitAdjacency() = default;
+
+    // 从任意 Graph 构建快照；节点 id 需为 0..n-1
+    static BitAdjacency fromGraph(const Graph& graph);
+
+    size_t getNodeCount() const { return n; }
+    // 每行（以及 visited 位图）占用的 64 位字数
+    size_t words() const { return wordsPerRow; }
+    const std::uint64_t* row(Index u) const {
+        return bits.data() + static_cast<size_t>(u) * wordsPerRow;
+    }
+
+private:
+    size_t n = 0;
+    size_t wordsPerRow = 0;
+    std::vector<std::uint64_t> bits;
+};
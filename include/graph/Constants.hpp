@@ -15,4 +15,40 @@ constexpr size_t FLUSH_CONTROL = 2500;
 constexpr size_t SMALL_SCALE = 9;
 
 // 小规模图的最大排列数
-constexpr int MAX_PERM_NUM = 9*8*7*6*5*4*3*2;
\ No newline at end of file
+constexpr int MAX_PERM_NUM = 9*8*7*6*5*4*3*2;
+
+// 预取流水线 BFS 默认的预取距离（提前多少个队列元素预取其邻接表）
+constexpr size_t PREFETCH_DISTANCE = 8;
+
+// 外存 BFS 每次顺序读写层文件的块大小（字节）
+constexpr size_t EXTERNAL_BLOCK_BYTES = 1 << 20;
+
+// 全根峰值测量（Metrics::measureDFSMaxStack / measureBFSMaxQueue）启用线程池并行的最小节点数；
+// 更小的图逐根串行，避免线程调度开销超过遍历本身
+constexpr size_t PARALLEL_ROOTS_MIN_NODES = 256;
+
+// 全根 BFS 峰值测量启用多源 BFS 上下界剪枝的最小节点数；更小的图直接逐根测量
+constexpr size_t MULTI_SOURCE_MIN_NODES = 64;
+
+// MeasureCache 默认的最大条目数（每条保存一次遍历的访问序与峰值）
+constexpr size_t MEASURE_CACHE_MAX_ENTRIES = 1 << 20;
+
+// MeasureCache 在前 MEASURE_CACHE_PROBE 次查找后，命中率低于 MEASURE_CACHE_MIN_HIT_RATE 时停用缓存、
+// 直接测量（结构序列与插入的开销已超过命中省下的遍历）
+constexpr size_t MEASURE_CACHE_PROBE = 4096;
+constexpr double MEASURE_CACHE_MIN_HIT_RATE = 0.3;
+
+// 缓存模拟指标（CacheSim）的默认模型，约为一级数据缓存：容量、行大小、相联度
+constexpr size_t CACHE_SIM_BYTES = 32 * 1024;
+constexpr size_t CACHE_SIM_LINE_BYTES = 64;
+constexpr size_t CACHE_SIM_WAYS = 8;
+
+// measureSpaceMetrics 的缓存缺失列用的小模型：容量取不超过遍历工作集（offsets / targets / visited / 边界）
+// 1 / CACHE_SIM_METRIC_FRACTION 的最大 2 的幂，行小、相联度低，使冲突与容量缺失随节点编号和邻居顺序变化
+// （默认模型下小图整体装得下，只剩与布局无关的首次缺失）
+constexpr size_t CACHE_SIM_METRIC_FRACTION = 2;
+constexpr size_t CACHE_SIM_METRIC_LINE_BYTES = 8;
+constexpr size_t CACHE_SIM_METRIC_WAYS = 2;
+
+// Tracer 每个线程最多缓存的追踪事件数，超出部分只计数不记录（约 64 字节 / 条）
+constexpr size_t TRACE_MAX_EVENTS_PER_THREAD = 1 << 20;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 扁平（CSR）邻接快照（只读）：u 的邻居为 targets[offsets[u] .. offsets[u+1])。
+// 邻居顺序与构建时 getNeighbors 的顺序一致，因此遍历序与 bfsTrace / dfsTrace 相同。
+// 所有邻接数据连续存放，便于对队列中后续节点的邻接区间做软件预取。
+// 数据既可以在内存中持有，也可以是 save() 写出的二进制文件的只读内存映射（mapFile），
+// 后者使超出内存的大图也能在单机上遍历。拷贝 CsrGraph 只共享底层数据，不复制。
+class CsrGraph {
+public:
+    CsrGraph() = default;
+
+    // 从任意 Graph 构建快照；节点 id 需为 0..n-1
+    static CsrGraph fromGraph(const Graph& graph);
+    // 从邻接表直接构建（大规模实验中避免先构造 AdjListGraph）
+    static CsrGraph fromAdjacency(const std::vector<std::vector<Index>>& adj);
+
+    // 二进制格式（本机字节序）：
+    //   "CSRGRAPH"(8B) | n(uint64) | m(uint64) | offsets[n+1](uint64) | targets[m](Index)
+    void save(const std::string& path) const;
+    // 只读映射 save() 写出的文件，并校验 offsets / targets 的结构（一次顺序扫描）；
+    // 打开失败、截断或结构损坏时抛出 std::runtime_error
+    static CsrGraph mapFile(const std::string& path);
+    bool isMapped() const { return mapped; }
+
+    size_t getNodeCount() const { return n; }
+    size_t getEdgeCount() const { return m; }
+
+    const std::uint64_t* offsetData() const { return offsets; }
+    const Index* targetData() const { return targets; }
+
+    const Index* neighborsBegin(Index u) const { return targets + offsets[static_cast<size_t>(u)]; }
+    const Index* neighborsEnd(Index u) const { return targets + offsets[static_cast<size_t>(u) + 1]; }
+
+private:
+    size_t n = 0;
+    size_t m = 0;
+    bool mapped = false;
+    const std::uint64_t* offsets = nullptr; // 长度 n + 1
+    const Index* targets = nullptr;         // 长度 m
+    // 持有内存中的数组或文件映射；offsets / targets 指向其中
+    std::shared_ptr<const void> storage;
+};
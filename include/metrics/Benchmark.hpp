@@ -0,0 +1,168 @@
+#pragma once
+#include "LatencyHistogram.hpp"
+#include "PerfCounters.hpp"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// 基准测试参数
+struct BenchOptions
+{
+    double warmupMs = 20.0;      // 每个配置正式采样前的预热时间
+    double minSampleNs = 2.0e5;  // 校准目标：单个样本（一批迭代）的最短耗时
+    std::size_t samples = 31;    // 每个配置的样本数（每个样本给出一个 ns / 次）
+    std::size_t maxIters = std::size_t(1) << 30; // 单个样本的迭代次数上限
+    int pinCpu = -1;             // >= 0 时把当前线程绑定到该 CPU
+    bool interleave = true;      // 每一轮随机打乱各配置的采样顺序
+    bool perfCounters = false;   // 每个样本前后读取硬件计数器（PerfCounters），不可用时只计时
+    unsigned seed = 0;
+};
+
+// 单个配置的结果（单位均为 ns / 次）
+struct BenchSummary
+{
+    std::string name;
+    std::size_t itersPerSample = 0;
+    std::vector<double> sampleNs; // 按采样先后顺序
+    double median = 0.0;
+    double mad = 0.0; // 中位数绝对偏差（未乘 1.4826）
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    PerfCounts counters; // 每次迭代的平均硬件计数（全部样本合计 / 总迭代次数），未采集时全为 -1
+
+    // 线性插值分位数，q ∈ [0, 1]
+    double percentile(double q) const;
+};
+
+// 并发吞吐测量参数
+struct ThroughputOptions
+{
+    unsigned threads = 1;     // 并发线程数 K
+    double durationMs = 500.0; // 所有线程同时开始后持续运行的时间
+    int pinBase = -1;          // >= 0 时第 t 个线程绑定到 CPU pinBase + t
+};
+
+// 并发吞吐结果：单次耗时（ns）按线程记入 LatencyHistogram，latency 为全部线程合并后的分布
+struct ThroughputResult
+{
+    unsigned threads = 0;
+    std::size_t totalOps = 0;
+    double seconds = 0.0; // 同时开始到最后一个线程完成当前操作的墙钟时间
+    double opsPerSec = 0.0;
+    std::vector<LatencyHistogram> perThread;
+    LatencyHistogram latency;
+};
+
+// 统计上可靠的计时：预热 -> 自动校准每个样本的迭代次数 -> 多轮采样（各配置随机交错，
+// 使频率漂移、其他进程干扰等慢变化均摊到所有配置上）-> 中位数 / MAD / 分位数。
+// 被测函数的返回值经 doNotOptimize 屏障“使用”，每次调用后再 clobberMemory，防止被优化掉或外提出循环。
+class Benchmark
+{
+public:
+    explicit Benchmark(const BenchOptions &options = BenchOptions()) : opt(options) {}
+
+    // 注册一个待比较的配置；fn 无参数，返回值（若有）会被屏障吸收
+    template <typename Func>
+    void add(std::string name, Func fn)
+    {
+        Case c;
+        c.name = std::move(name);
+        c.runBatch = [fn](std::size_t iters) mutable -> double
+        {
+            using Clock = std::chrono::steady_clock;
+            const auto t0 = Clock::now();
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                if constexpr (std::is_void<decltype(fn())>::value)
+                {
+                    fn();
+                }
+                else
+                {
+                    doNotOptimize(fn());
+                }
+                clobberMemory();
+            }
+            const auto t1 = Clock::now();
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        };
+        cases.push_back(std::move(c));
+    }
+
+    std::size_t size() const { return cases.size(); }
+
+    // 依次预热、校准全部配置，然后交错采样；结果与 add 的顺序一致
+    std::vector<BenchSummary> run();
+
+    // 最近一次 run 的计数器状态：已打开的事件列表或不可用原因；未开启 perfCounters 时为空
+    const std::string &perfStatus() const { return perfStatusText; }
+
+    // 结果写成 CSV（计时与硬件计数在同一行，不可用的计数留空）；失败时抛出 std::runtime_error
+    static void writeCsv(const std::string &path, const std::vector<BenchSummary> &results);
+
+    // K 个线程同时反复执行各自的操作 durationMs，返回总吞吐与每线程单次耗时分布。
+    // makeWorker(t) 在第 t 个线程内调用并返回该线程要反复执行的操作：共享图时捕获同一对象，
+    // 私有副本应在 makeWorker 内构造，使其内存由本线程首次触碰
+    static ThroughputResult measureThroughput(const std::function<std::function<void()>(unsigned)> &makeWorker,
+                                              const ThroughputOptions &options = ThroughputOptions());
+
+    // 由样本（ns / 次）计算统计量
+    static BenchSummary summarize(std::string name, std::vector<double> sampleNs, std::size_t itersPerSample);
+
+    // 把当前线程绑定到 cpu（Linux / Windows），不支持或失败时返回 false
+    static bool pinCurrentThread(int cpu);
+
+    // 让编译器认为 value 被读取（且可能被修改），阻止计算被消除
+    template <typename T>
+    static void doNotOptimize(T &&value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        using V = typename std::decay<T>::type;
+        if constexpr (std::is_trivially_copyable<V>::value && sizeof(V) <= sizeof(void *))
+            asm volatile("" : : "r,m"(value) : "memory");
+        else
+            asm volatile("" : : "m"(value) : "memory");
+#else
+        sinkAddress(&value);
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // 编译器内存屏障：阻止内存读写跨越该点被合并或外提
+    static void clobberMemory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+private:
+    struct Case
+    {
+        std::string name;
+        std::function<double(std::size_t)> runBatch; // 运行 iters 次，返回总耗时（ns）
+        std::size_t iters = 1;
+        std::vector<double> samples;
+        PerfCounts counterSum;
+    };
+
+    void warmupAndCalibrate(Case &c) const;
+#if !defined(__GNUC__) && !defined(__clang__)
+    static void sinkAddress(const void *p);
+#endif
+
+    BenchOptions opt;
+    std::vector<Case> cases;
+    std::string perfStatusText;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Constants.hpp"
+
+// 组相联缓存的几何参数；sizeBytes / lineBytes / ways 须使组数为 2 的幂
+struct CacheConfig
+{
+    std::size_t sizeBytes = CACHE_SIM_BYTES;
+    std::size_t lineBytes = CACHE_SIM_LINE_BYTES;
+    std::size_t ways = CACHE_SIM_WAYS;
+};
+
+struct CacheStats
+{
+    std::size_t accesses = 0; // 按缓存行计（跨行的访问计为多次）
+    std::size_t misses = 0;
+
+    double missRate() const { return accesses == 0 ? 0.0 : static_cast<double>(misses) / static_cast<double>(accesses); }
+};
+
+// 确定性的组相联 LRU 缓存模型：只关心地址序列，与机器无关。
+// 地址为调用方自行排布的虚拟地址（例如把 offsets / targets / visited / 队列放到各自的区间），
+// 因此同一遍历序在任何机器上都得到相同的缺失数
+class CacheSim
+{
+public:
+    // 参数不合法（为 0、行大小或组数不是 2 的幂、容量不能整除）时抛出 std::invalid_argument
+    explicit CacheSim(const CacheConfig &config = CacheConfig());
+
+    // 访问 [addr, addr + bytes) 覆盖的每一行
+    void access(std::uint64_t addr, std::size_t bytes = 1);
+
+    const CacheStats &stats() const { return counters; }
+    void reset(); // 清空缓存内容与统计
+
+private:
+    std::size_t lineShift = 0;
+    std::size_t setMask = 0;
+    std::size_t ways = 0;
+    std::vector<std::uint64_t> tags;  // [set * ways + way]，存行号 + 1，0 表示空
+    std::vector<std::uint64_t> stamp; // 最近一次使用的时间戳，越小越久未用
+    std::uint64_t clock = 0;
+    CacheStats counters;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+// 字节计数器：记录经由 CountingAllocator 分配、当前仍存活的字节数及其峰值。
+// parent 指向汇总计数器（例如“全部遍历容器”），增减会同步传递上去，
+// 因此汇总计数器的 peak 是各容器“同时存活”字节之和的峰值，而不是各自峰值之和。
+// 不加锁：一个计数器只应被单个线程使用
+struct ByteCounter
+{
+    std::size_t live = 0;
+    std::size_t peak = 0;
+    ByteCounter *parent = nullptr;
+
+    void add(std::size_t bytes)
+    {
+        live += bytes;
+        peak = std::max(peak, live);
+        if (parent)
+            parent->add(bytes);
+    }
+
+    void sub(std::size_t bytes)
+    {
+        live -= bytes;
+        if (parent)
+            parent->sub(bytes);
+    }
+};
+
+// 计数分配器：实际分配交给 std::allocator，同时把字节数记到 ByteCounter 上。
+// 用于 std::deque（std::queue / std::stack 的底层容器）时，统计到的是块与映射表的真实分配，
+// 块大小与映射表增长策略由标准库实现决定（libstdc++ 每块 512 字节，MSVC 每块 16 字节）
+template <typename T>
+class CountingAllocator
+{
+public:
+    using value_type = T;
+
+    explicit CountingAllocator(ByteCounter *counter) noexcept : counter(counter) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) noexcept : counter(other.byteCounter()) {}
+
+    T *allocate(std::size_t n)
+    {
+        T *p = std::allocator<T>().allocate(n);
+        counter->add(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        counter->sub(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    ByteCounter *byteCounter() const noexcept { return counter; }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &other) const noexcept { return counter == other.byteCounter(); }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U> &other) const noexcept { return counter != other.byteCounter(); }
+
+private:
+    ByteCounter *counter;
+};
@@ -12,6 +12,8 @@ public:
     const std::map<size_t, std::vector<std::vector<std::string>>>& getDistribution();
     void clear();
     void toCsv(const std::string& path) const;
+    // 读回 toCsv 写出的文件（key,count,"rank | rank ..."，rank 内以 ';' 分隔）；失败时抛出 std::runtime_error
+    static DistributionStorage fromCsv(const std::string& path);
     unsigned long long size();
 private:
     std::map<size_t, std::vector<std::vector<std::string>>> distribution;
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 对数-线性（HDR 风格）直方图：每个 2 的幂区间再等分为 2^PRECISION_BITS 个子桶，
+// 小于 2^(PRECISION_BITS+1) 的值精确计数，更大的值相对误差不超过 2^-PRECISION_BITS（约 0.8%）。
+// 记录为 O(1)（一次取最高位 + 一次计数），计数数组按需增长，只覆盖已出现过的量级；
+// 两个直方图可直接逐桶相加合并。适合常开记录每次遍历的耗时（ns）
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned PRECISION_BITS = 7;
+
+    void record(std::uint64_t value) { recordN(value, 1); }
+    void recordN(std::uint64_t value, std::uint64_t count);
+    void merge(const LatencyHistogram &other);
+    void clear();
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t min() const { return total == 0 ? 0 : lo; }
+    std::uint64_t max() const { return hi; }
+    double mean() const { return total == 0 ? 0.0 : sum / static_cast<double>(total); }
+
+    // 分位数，q ∈ [0, 1]：返回第 ceil(q * count) 个值所在桶的中点（夹在 [min, max] 内）
+    std::uint64_t percentile(double q) const;
+
+    std::size_t bucketCount() const { return counts.size(); }
+
+private:
+    static std::size_t indexOf(std::uint64_t value);
+    static std::uint64_t lowerOf(std::size_t index);
+    static std::uint64_t upperOf(std::size_t index); // 桶内最大值
+
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total = 0;
+    std::uint64_t lo = UINT64_MAX;
+    std::uint64_t hi = 0;
+    double sum = 0.0;
+};
+
+// 多线程记录：每个线程首次调用 local() 时登记一个自己的 LatencyHistogram，之后记录无锁、无共享写；
+// merged() 汇总所有线程的实例。读取 merged() 时各线程应已停止记录
+class ConcurrentHistogram
+{
+public:
+    ConcurrentHistogram();
+    ConcurrentHistogram(const ConcurrentHistogram &) = delete;
+    ConcurrentHistogram &operator=(const ConcurrentHistogram &) = delete;
+
+    LatencyHistogram &local();
+    LatencyHistogram merged() const;
+
+private:
+    std::uint64_t id; // 区分实例（地址可能被复用）
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<LatencyHistogram>> shards;
+};
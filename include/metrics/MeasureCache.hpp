@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Graph.hpp"
+#include "Constants.hpp"
+
+// 单根遍历测量结果的缓存（用于全排列实验中大量重复的 (排列, 根) 组合）。
+// 遍历结果（按标签给出的访问序与峰值）只取决于：
+//   1) 标签空间中的邻居顺序结构：每个标签的有序邻居标签列表（与节点 id 无关）；
+//   2) 根的标签；3) 遍历算法。
+// 标签首次出现时编为稠密整数 id；结构按 id 写成规范序列，整条序列作为键精确比较（不依赖哈希无碰撞），
+// 每种不同结构得到一个结构编号。缓存以 (结构编号, 根标签 id, 算法) 为键，命中时跳过遍历。
+// AdjList 的重排保留邻居在原 id 下的顺序，所有排列结构相同；AdjMatrix 中只改变
+// 无关节点相对顺序的排列同样会命中。注意：自同构下等价但标签不同的配置不会合并
+// （例如 AdjMatrix 上的星图，叶子的顺序随编号变化，命中率上限为 1 - 1/n）。
+// 图中有重复标签时根标签不能确定根，这样的图不缓存、直接测量。
+// 命中率过低时（见 MEASURE_CACHE_PROBE / MEASURE_CACHE_MIN_HIT_RATE）自动停用，之后直接测量。
+class MeasureCache {
+public:
+    enum class Algo { DFS, BFS };
+
+    // structureOf 的结果：cacheable 为 false 时（缓存已停用、有重复标签或结构表已满）measure 直接测量
+    struct Structure {
+        std::uint32_t id = 0;
+        std::uint64_t serial = 0; // 第几次 structureOf 调用，用于复用该次调用中各节点的标签 id
+        bool cacheable = false;
+    };
+
+    // maxEntries：缓存条目上限，达到后不再插入新条目与新结构（查找照常）
+    explicit MeasureCache(std::size_t maxEntries = MEASURE_CACHE_MAX_ENTRIES);
+
+    // 图的结构编号，O(n log n + m)；同一张图的多个根可复用
+    Structure structureOf(const Graph& graph);
+
+    // 测量 root 出发的遍历（Metrics::measure{DFSMaxStack,BFSMaxQueue}FromRoot），
+    // structure 为 structureOf(graph)。返回峰值，order 为访问序
+    std::size_t measure(Graph& graph, const Structure& structure, Index root, Algo algo,
+                        std::vector<std::string>& order);
+
+    std::size_t hits() const { return hitCount; }
+    std::size_t misses() const { return missCount; }
+    // 未经缓存直接测量的次数（停用后或不可缓存的图；不计入 hits / misses）
+    std::size_t bypassed() const { return bypassCount; }
+    bool active() const { return enabled; }
+    double hitRate() const;
+    std::size_t size() const { return entries.size(); }
+    void clear(); // 之前得到的 Structure 随之失效，须重新 structureOf
+
+private:
+    struct Key {
+        std::uint32_t structure;
+        std::uint32_t root; // 根的标签 id
+        Algo algo;
+        bool operator==(const Key& o) const noexcept
+        {
+            return structure == o.structure && root == o.root && algo == o.algo;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const noexcept;
+    };
+    struct SequenceHash {
+        std::size_t operator()(const std::vector<std::uint32_t>& s) const noexcept;
+    };
+    struct Entry {
+        std::size_t space = 0;
+        std::vector<std::string> order;
+    };
+
+    std::size_t measureDirect(Graph& graph, Index root, Algo algo, std::vector<std::string>& order);
+
+    std::size_t maxEntries;
+    bool enabled = true;
+    std::unordered_map<std::string, std::uint32_t> labelIds;
+    std::unordered_map<std::vector<std::uint32_t>, std::uint32_t, SequenceHash> structures;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    // 最近一次 structureOf 的临时数据，跨调用复用
+    std::uint64_t lastSerial = 0;
+    std::vector<std::uint32_t> nodeLabel;      // 节点 -> 标签 id
+    std::vector<Index> byLabel;                // 按标签 id 排序的节点
+    std::vector<std::uint32_t> sequence;       // 规范序列
+    std::size_t hitCount = 0;
+    std::size_t missCount = 0;
+    std::size_t bypassCount = 0;
+};
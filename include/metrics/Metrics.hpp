@@ -2,20 +2,75 @@
 
 #include "Graph.hpp"
 #include "TraversalAlgo.hpp"
+#include "OccupancyTimeline.hpp"
+#include "CacheSim.hpp"
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <chrono>
 
 struct RootOptResult
 {
     std::size_t bestPeak = 0;     // 最小的“最大占用”
     std::vector<Index> bestRoots; // 所有达到 bestPeak 的 ROOT
+
+    // 仅字节模式（measure*Bytes）填写：遍历容器总字节峰值的最小值及达到它的 ROOT（升序）。
+    // deque 按块分配、映射表按历史增长，字节排名与元素数排名可能不一致
+    std::size_t bestPeakBytes = 0;
+    std::vector<Index> bestBytesRoots;
+};
+
+// 单次遍历中各容器的存活字节峰值（CountingAllocator 统计的真实分配）
+struct ContainerBytes
+{
+    std::size_t frontier = 0; // std::queue / std::stack 底层 std::deque 的块与映射表
+    std::size_t visited = 0;
+    std::size_t nextIdx = 0;  // 仅 Path-DFS 使用
+    std::size_t total = 0;    // 三者同时存活字节之和的峰值
+};
+
+// 抽样估计全根峰值的参数
+struct PeakEstimateOptions
+{
+    double delta = 0.05;             // 置信界的失败概率
+    std::size_t initialSamples = 64; // 第一轮抽样的根数，之后每轮翻倍
+    double timeBudgetMs = 1000.0;    // 时间预算；当前轮结束时超出即停止
+    std::size_t maxSamples = 0;      // 抽样总数上限，0 表示不限（直到抽尽全部根）
+    unsigned seed = 0;
+};
+
+// 抽样估计结果：bestPeak / bestRoots 为已评估根中的最优值（真实最优值只会更小或相等）
+struct PeakEstimate
+{
+    std::size_t bestPeak = 0;
+    std::vector<Index> bestRoots; // 已评估根中达到 bestPeak 的根（升序）
+    std::size_t sampled = 0;
+    std::size_t totalRoots = 0;
+    std::size_t rounds = 0;
+    bool exact = false;               // 全部根都已评估，结果与精确测量相同
+    double confidence = 0.95;         // 1 - delta
+    double betterFractionBound = 0.0; // 以 confidence 的概率，峰值严格小于 bestPeak 的根所占比例不超过该值
+    double elapsedMs = 0.0;
+};
+
+// Utility::doSpaceMeasure 需要的全部空间指标
+struct SpaceMetrics
+{
+    RootOptResult bfsMaxQueue;
+    RootOptResult dfsMaxStack;
+    double bfsHDS = 0.0;
+    double dfsHDS = 0.0;
+    double bfsBS = 0.0;
+    double dfsBS = 0.0;
+    std::size_t bfsCacheMiss = 0; // 随工作集缩放的小缓存模型下的模拟缺失数（见 CACHE_SIM_METRIC_*）
+    std::size_t dfsCacheMiss = 0;
 };
 
 class Metrics
 {
 public:
-    // 测量遍历时间（ns / 次）
+    // 测量遍历时间（ns / 次）：repeat 次的简单平均，无预热与离群处理；
+    // 比较不同布局的耗时请使用 Benchmark（Benchmark.hpp）
     template <typename Func>
     static double measureAveTraverlsalTime(Graph &g, Func algo, int repeat)
     {
@@ -42,6 +97,41 @@ public:
     static RootOptResult measureDFSMaxStack(Graph &graph);
     static RootOptResult measureBFSMaxQueue(Graph &graph);
 
+    // 字节模式：与 measure*FromRoot 相同的 std::queue / std::stack 遍历，容器改用 CountingAllocator，
+    // 返回各容器的存活字节峰值；遍历邻接取自快照，getNeighbors 的临时拷贝不计入
+    static ContainerBytes measureBFSBytesFromRoot(Graph &graph, Index root);
+    static ContainerBytes measureDFSBytesFromRoot(Graph &graph, Index root);
+    // 全根字节模式：同一次遍历同时给出元素数口径（bestPeak / bestRoots）与字节口径
+    // （bestPeakBytes / bestBytesRoots）；每个根都要真实分配容器，比 measure*Max* 慢，不做剪枝
+    static RootOptResult measureBFSMaxQueueBytes(Graph &graph);
+    static RootOptResult measureDFSMaxStackBytes(Graph &graph);
+
+    // 记录从 root 出发的 BFS 队列 / Path-DFS 路径栈占用曲线（每次入队、出队各为一步），返回峰值。
+    // 与 measure*FromRoot 的遍历完全相同；不需要曲线时内核以 NullRecorder 实例化，无额外开销
+    static std::size_t recordBFSOccupancy(Graph &graph, Index root, OccupancyTimeline &timeline);
+    static std::size_t recordDFSOccupancy(Graph &graph, Index root, OccupancyTimeline &timeline);
+
+    // 大图上的抽样估计：按度数分层抽取根并精确测量，样本量逐轮翻倍直到时间预算用完，
+    // 返回已观测的最优峰值及“还有多少比例的根可能更优”的置信上界
+    static PeakEstimate estimateBFSMaxQueue(Graph &graph, const PeakEstimateOptions &options = PeakEstimateOptions());
+    static PeakEstimate estimateDFSMaxStack(Graph &graph, const PeakEstimateOptions &options = PeakEstimateOptions());
+
+    // 缓存模拟：按 CSR 布局（offsets / targets）与 visited、队列 / 栈数组排布虚拟地址，
+    // 把从 ROOT 出发的 bfsTrace / dfsTrace 遍历中的全部邻接读取与 visited、边界读写交给 CacheSim 回放。
+    // 结果只取决于节点编号与邻居顺序，与机器无关，可用于给不同布局按局部性排序
+    static CacheStats measureBFSCacheMisses(Graph &graph, const CacheConfig &config = CacheConfig());
+    static CacheStats measureDFSCacheMisses(Graph &graph, const CacheConfig &config = CacheConfig());
+
+    // 融合测量：一次邻接快照上完成两种全根峰值，BFS / DFS 各只遍历一次 trace，
+    // HDS 与 BS 共用访问秩数组，度数排序只做一次。结果与分别调用
+    // measureBFSMaxQueue / measureDFSMaxStack / measureHighDegreeSpacing / measureBranchSuspension
+    // （trace 取 TraversalAlgo::bfsTrace / dfsTrace）完全相同
+    static SpaceMetrics measureSpaceMetrics(Graph &graph);
+
+    // 图为森林（无向无环）时，用换根 DP 在 O(n) 内求出每个根的 Path-DFS 栈峰值（peaks[r]）及 res；
+    // 不是森林时返回 false。measureDFSMaxStack 遇到森林会自动走这条路径
+    static bool measureForestDFSMaxStack(Graph &graph, RootOptResult &res, std::vector<std::size_t> &peaks);
+
     // 测量一张图从ROOT == 0开始的最大空间占用, 并返回遍历序列
     static size_t measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string> &order);
     static size_t measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string> &order);
@@ -50,10 +140,25 @@ public:
     static size_t measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string> &order, Index root);
     static size_t measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string> &order, Index root);
 
+    // 有界内存遍历模式：返回边界峰值与遍历序列，expansions 返回邻接表扫描总次数（衡量额外工作）
+    // IDDFS：路径栈峰值 + 逐轮深度表的 n 个元素（TraversalCost::auxiliary）；限队列 BFS：队列峰值（不超过 budget）
+    static size_t measureIDDFSMaxStackFromRoot(Graph &graph, std::vector<std::string> &order, Index root,
+                                               std::size_t &expansions);
+    static size_t measureCappedBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string> &order, Index root,
+                                                   std::size_t budget, std::size_t &expansions);
+
     // 比较两个遍历序列的相似程度，范围为[0.0, 1.0]。
     // 越接近1.0表示两个序列越接近，1.0表示两个序列完全相同
     static double getLcsSimilarity(const std::vector<std::string> &orderA,
                                    const std::vector<std::string> &orderB);
+    // 整数编码（标签 id）版本：位并行 LCS，无字符串比较
+    static double getLcsSimilarity(const std::vector<int> &orderA, const std::vector<int> &orderB);
+    // 最长公共子序列长度，O(|A|·|B| / 64)
+    static std::size_t lcsLength(const std::vector<int> &orderA, const std::vector<int> &orderB);
+    // 复用 A 预先建好的匹配位图：A 长 m，match 每行 (m + 63) / 64 个字，
+    // rowOf[id] 为 id 在 match 中的行号（不在 A 中为 -1）。批量逐对计算时避免重复建表
+    static std::size_t lcsLength(const std::uint64_t *match, std::size_t m, const std::vector<int> &rowOf,
+                                 const std::vector<int> &orderB);
     static double getKendallSimilarity(const std::vector<std::string> &orderA,
                                        const std::vector<std::string> &orderB);
     /******************************  Deprecated Code Begin ******************************/
@@ -75,7 +180,7 @@ public:
         return branchSuspensionImpl(t);
     }
 
-    // Pearson 相关系数
+    // Pearson 相关系数（单遍 RunningCovariance 实现；样本无需全部保存时直接使用 RunningCovariance）
     static double pearsonCorr(const std::vector<double> &x,
                               const std::vector<double> &y);
     /******************************  Deprecated Code End ******************************/
@@ -83,6 +188,4 @@ private:
     static double highDegreeSpacingImpl(const Graph &graph, const TraversalTrace &t);
     static double branchSuspensionImpl(const TraversalTrace &t);
     static bool hasHighDegreeNode(Graph &graph);
-    static std::size_t dfsMaxStackFromRoot(Graph &graph, Index root);
-    static std::size_t bfsMaxQueueFromRoot(Graph &graph, Index root);
 };
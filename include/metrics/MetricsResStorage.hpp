@@ -10,7 +10,7 @@ public:
 
     void clear();
     void merge(MetricsResStorage& another);
-    // 参数顺序：bfsMaxQueue, dfsMaxStack, bfsHDS, dfsHDS, bfsBS, dfsBS, label
+    // 参数顺序：bfsMaxQueue, dfsMaxStack, bfsHDS, dfsHDS, bfsBS, dfsBS, bfsCacheMiss, dfsCacheMiss, label
     bool append(
         RootOptResult _bfsMaxQueue,
         RootOptResult _dfsMaxStack,
@@ -18,6 +18,8 @@ public:
         double _dfsHDS,
         double _bfsBS,
         double _dfsBS,
+        size_t _bfsCacheMiss,
+        size_t _dfsCacheMiss,
         std::string _label
     );
     const std::vector<RootOptResult>& getDfsMaxStack() const;
@@ -26,6 +28,8 @@ public:
     const std::vector<double>& getDfsHDS() const;
     const std::vector<double>& getBfsBS() const;
     const std::vector<double>& getDfsBS() const;
+    const std::vector<size_t>& getBfsCacheMiss() const;
+    const std::vector<size_t>& getDfsCacheMiss() const;
     const std::vector<std::string>& getLabel() const;
     size_t getResGroupSize() const;
 private:
@@ -36,5 +40,7 @@ private:
     std::vector<double> dfsHDS;
     std::vector<double> bfsBS;
     std::vector<double> dfsBS;
+    std::vector<size_t> bfsCacheMiss;
+    std::vector<size_t> dfsCacheMiss;
     std::vector<std::string> label;
 };
\ No newline at end of file
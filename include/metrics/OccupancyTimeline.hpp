@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 遍历内核的占用记录策略：内核在每次入队/出队（入栈/出栈）后调用 record(当前大小)。
+// NullRecorder 的 record 为空内联函数，内核以它实例化时记录代码被完全优化掉。
+struct NullRecorder
+{
+    void record(std::size_t) {}
+};
+
+// 完整的占用曲线（从 0 开始，每次 record 为一步），以“相同增量的连续步”游程编码：
+// 遍历中每一步的增量几乎总是 +1 或 -1，连续入队 / 连续出队各只占一个游程，
+// record 为均摊 O(1)，内存与游程数成正比。
+class OccupancyTimeline
+{
+public:
+    void record(std::size_t size);
+    void clear();
+
+    std::size_t steps() const { return stepCount; }
+    std::size_t peak() const { return maxSize; }
+    std::size_t runCount() const { return runs.size(); }
+
+    // 展开为逐步的占用序列（长度 steps()），用于绘图或导出
+    std::vector<std::size_t> expand() const;
+
+    // 曲线下面积：Σ 每一步之后的占用
+    double areaUnderCurve() const;
+    // 平均占用 = areaUnderCurve / steps
+    double meanOccupancy() const;
+    // 占用严格大于 threshold 的步数
+    std::size_t stepsAbove(std::size_t threshold) const;
+
+private:
+    struct Run
+    {
+        std::int64_t delta = 0;
+        std::size_t count = 0;
+    };
+
+    std::vector<Run> runs;
+    std::size_t current = 0;
+    std::size_t stepCount = 0;
+    std::size_t maxSize = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 一次（或多次累加的）硬件计数结果；不可用的事件为 -1
+struct PerfCounts
+{
+    enum Event
+    {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1dMisses,  // L1 数据缓存读缺失
+        LlcMisses,  // 末级缓存缺失
+        EventCount
+    };
+
+    double value[EventCount] = {-1.0, -1.0, -1.0, -1.0, -1.0};
+
+    bool has(Event e) const { return value[e] >= 0.0; }
+    bool valid() const; // 至少一个事件可用
+    double ipc() const; // instructions / cycles，不可用时为 -1
+
+    // 逐事件相加（一方不可用时取另一方）
+    void accumulate(const PerfCounts &other);
+    // 每个可用事件除以 divisor（例如换算成每次迭代）
+    PerfCounts per(double divisor) const;
+
+    static const char *name(Event e);
+};
+
+// 围绕一段代码读取当前线程的硬件计数器：Linux 上用 perf_event_open 打开一个计数器组
+// （周期、指令、分支预测失败、L1D 读缺失、LLC 缺失，只计用户态），组内事件同时启停，
+// 被内核轮换（multiplex）时按 enabled / running 比例缩放。
+// 单个事件不被支持时跳过该事件；全部打开失败（权限、虚拟机、非 Linux）时 available() 为 false，
+// start / stop 变为空操作并返回全 -1，调用方只保留计时即可
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const { return leader >= 0; }
+    // 可用时为已打开的事件列表，不可用时为原因
+    const std::string &status() const { return statusText; }
+
+    void start();
+    PerfCounts stop(); // 自上一次 start 以来的计数
+
+private:
+    int leader = -1;
+    std::vector<int> fds;                  // fds[0] == leader
+    std::vector<PerfCounts::Event> events; // 与 fds 一一对应
+    std::string statusText;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 一组访问秩两两之间的相似度（批量版本的 Metrics::getKendallSimilarity / getLcsSimilarity）。
+// 构造时把所有标签统一编码为整数 id，并为每个访问秩预先建好“id -> 位置”数组；
+// 按行在线程池上并行计算，每行的 LCS 匹配位图只建一次（L × ⌈L/64⌉ 个字，L 为该访问秩长度，
+// 每个线程同时只持有一行），之后每一对只做整数运算。结果与逐对调用 Metrics 完全一致。
+class SimilarityMatrix
+{
+public:
+    enum class Kind
+    {
+        Kendall,
+        LCS
+    };
+
+    explicit SimilarityMatrix(const std::vector<std::vector<std::string>> &ranks);
+
+    std::size_t size() const { return coded.size(); }
+
+    double similarity(std::size_t i, std::size_t j, Kind kind) const;
+
+    // 完整 N×N 矩阵（行主序）；相似度对称时只计算上三角
+    std::vector<double> full(Kind kind) const;
+
+    // 每个访问秩与其余访问秩中最相似的 k 个：(编号, 相似度)，相似度降序、编号升序
+    std::vector<std::vector<std::pair<std::size_t, double>>> topK(Kind kind, std::size_t k) const;
+
+    // 按行顺序流式写出，每次只在内存中保留 blockRows 行（至多 blockRows × N 个 double）。
+    // 相似度对称时只写上三角，每对只计算一次。二进制格式（本机字节序）：
+    //   "SIMMAT02"(8B) | N(uint64) | kind(uint64, 0 = Kendall, 1 = LCS) | layout(uint64) | 数据
+    //   layout 0：N×N 个 double（行主序）；layout 1：上三角按行压缩，第 i 行为 j = i..N-1，共 N(N+1)/2 个 double
+    // scripts/read_similarity_matrix.py 读取两种布局并还原为完整矩阵。失败时抛出 std::runtime_error
+    void writeBinary(const std::string &path, Kind kind, std::size_t blockRows = 256) const;
+
+private:
+    double kendall(std::size_t i, std::size_t j) const;
+    // 行 a 的预处理（LCS 时建匹配位图，Kendall 时为空），之后 rowSimilarity(a, ·) 复用
+    void prepareRow(std::size_t a, Kind kind, std::vector<std::uint64_t> &matchA) const;
+    double rowSimilarity(std::size_t a, std::size_t b, Kind kind, const std::vector<std::uint64_t> &matchA) const;
+
+    std::size_t labelCount = 0;
+    bool hasDuplicates = false; // 某个访问秩内有重复标签
+    std::vector<std::vector<int>> coded; // 每个访问秩的标签 id 序列
+    std::vector<std::vector<int>> pos;   // pos[r][id]：id 在访问秩 r 中的位置，不存在为 -1
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+// 单遍流式统计量：逐个喂入样本，不保存样本本身；两个累加器可合并（例如各线程分别统计后汇总）
+
+// 均值 / 方差（Welford）
+class RunningStats
+{
+public:
+    void push(double x);
+    void merge(const RunningStats &other);
+
+    std::size_t count() const { return n; }
+    double mean() const { return mu; }
+    double variance() const;       // 总体方差（除以 n）
+    double sampleVariance() const; // 样本方差（除以 n - 1）
+    double stddev() const;         // 总体标准差
+    double min() const { return lo; }
+    double max() const { return hi; }
+
+private:
+    std::size_t n = 0;
+    double mu = 0.0;
+    double m2 = 0.0; // 离差平方和
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -std::numeric_limits<double>::infinity();
+};
+
+// 两个变量的协方差与 Pearson 相关系数（共矩 C = Σ(x - x̄)(y - ȳ) 的单遍更新）
+class RunningCovariance
+{
+public:
+    void push(double x, double y);
+    void merge(const RunningCovariance &other);
+
+    std::size_t count() const { return sx.count(); }
+    const RunningStats &statsX() const { return sx; }
+    const RunningStats &statsY() const { return sy; }
+    double covariance() const; // 总体协方差
+    // 与 Metrics::pearsonCorr 口径一致：样本不足 2 个或任一方差为 0 时返回 0.0
+    double pearson() const;
+
+private:
+    RunningStats sx;
+    RunningStats sy;
+    double cxy = 0.0;
+};
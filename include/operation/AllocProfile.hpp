@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// 分配剖析：以 TRIAL_ALLOC_PROFILE 编译（CMake: -DTRIAL_ALLOC_PROFILE=ON）时替换全局 operator new / delete
+// （含数组、nothrow 与对齐版本），每次分配带一个小头部记录大小与归属，按“阶段 × 调用点”统计
+// 分配次数 / 字节数以及对应的释放次数 / 字节数（释放记回分配时的归属，差值即仍存活的字节）。
+// 阶段由 TRIAL_ALLOC_PHASE 标记，调用点由 TRIAL_ALLOC_SITE 标记，二者都按线程取最内层。
+// 未开启时两个宏为空语句、不替换 operator new，对程序没有任何影响
+class AllocProfile {
+public:
+#if defined(TRIAL_ALLOC_PROFILE)
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // 可区分的阶段 / 调用点数量（含编号 0 的“未标记”）；超出的名字归入最后一个 "(other)"
+    static constexpr int MAX_PHASES = 64;
+    static constexpr int MAX_SITES = 32;
+
+    struct Row {
+        std::string phase;
+        std::string site;
+        std::uint64_t allocs = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t frees = 0;
+        std::uint64_t freedBytes = 0;
+    };
+
+    // 所有非空的 阶段 × 调用点 统计
+    static std::vector<Row> rows();
+    static void reset();
+    // CSV：逐 阶段 × 调用点，随后为各阶段合计（site 为 "*"）与各调用点合计（phase 为 "*"）
+    static void report(std::ostream& os);
+
+    static int phaseId(const std::string& name);
+    static int siteId(const char* name);
+
+    class Phase {
+    public:
+        explicit Phase(const std::string& name);
+        ~Phase();
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        int prev;
+    };
+
+    class Site {
+    public:
+        explicit Site(int id);
+        ~Site();
+        Site(const Site&) = delete;
+        Site& operator=(const Site&) = delete;
+
+    private:
+        int prev;
+    };
+};
+
+#define TRIAL_ALLOC_CONCAT_IMPL(a, b) a##b
+#define TRIAL_ALLOC_CONCAT(a, b) TRIAL_ALLOC_CONCAT_IMPL(a, b)
+
+#if defined(TRIAL_ALLOC_PROFILE)
+#define TRIAL_ALLOC_PHASE(name) ::AllocProfile::Phase TRIAL_ALLOC_CONCAT(trialAllocPhase_, __LINE__)(name)
+// 调用点名字只在首次经过时登记一次
+#define TRIAL_ALLOC_SITE(name)                                                                          \
+    static const int TRIAL_ALLOC_CONCAT(trialAllocSiteId_, __LINE__) = ::AllocProfile::siteId(name); \
+    ::AllocProfile::Site TRIAL_ALLOC_CONCAT(trialAllocSite_, __LINE__)(TRIAL_ALLOC_CONCAT(trialAllocSiteId_, __LINE__))
+#else
+#define TRIAL_ALLOC_PHASE(name) ((void)0)
+#define TRIAL_ALLOC_SITE(name) ((void)0)
+#endif
@@ -2,6 +2,7 @@
 
 #include "AdjListGraph.hpp"
 #include "AdjMatrixGraph.hpp"
+#include "CsrGraph.hpp"
 #include <random>
 #include <string>
 #include <stdexcept>
@@ -111,4 +112,9 @@ public:
     // Binary tree in array form: for node i, children are 2i+1 and 2i+2 if < n.
     static AdjListGraph makeBinaryTreeAdjList(int n);
     static AdjMatrixGraph makeBinaryTreeAdjMatrix(int n);
+
+    // Large sparse random graph directly in CSR form (for out-of-cache / out-of-core experiments):
+    // a random Hamiltonian path (guarantees connectivity) plus ~n*(avgDeg-2)/2 random undirected edges.
+    // Node ids are shuffled so adjacency has no locality. Deterministic for a given seed.
+    static CsrGraph makeSparseRandomCsr(size_t n, size_t avgDeg, unsigned seed);
 };
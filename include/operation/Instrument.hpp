@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// 热路径计数：图（getNeighbors 调用与拷贝的元素数、getNode 拷贝）、遍历与指标内核（visited 检查、入队/入栈、出队/出栈）、
+// RankSeeking（搜索状态、记忆化剪枝、分支）。只有以 TRIAL_INSTRUMENT 编译
+// （CMake: -DTRIAL_INSTRUMENT=ON）时 TRIAL_COUNT / TRIAL_PHASE 才展开为代码，否则为空语句，参数也不求值。
+// 计数器按线程私有、无锁累加；TRIAL_PHASE 在作用域结束时把期间所有线程的计数增量记到该阶段名下（嵌套阶段各自包含子阶段）。
+class Instrument {
+public:
+    enum Counter {
+        NeighborCalls,  // getNeighbors 调用次数
+        NeighborCopies, // getNeighbors 拷贝出的邻居元素数
+        NodeCopies,     // getNode 调用次数（每次拷贝一个 Node 及其 label）
+        VisitedChecks,
+        Pushes,
+        Pops,
+        RankStates,     // RankSeeking 进入的搜索状态数
+        RankMemoPrunes, // 被记忆化表剪掉的状态数
+        RankBranches,   // 展开的分支数
+        CounterCount
+    };
+
+#if defined(TRIAL_INSTRUMENT)
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    struct Snapshot {
+        std::uint64_t value[CounterCount] = {};
+    };
+
+    // 单个线程的计数块，由 registerThread 分配并登记，线程退出后仍保留以免丢失计数
+    struct Block {
+        std::atomic<std::uint64_t> value[CounterCount] = {};
+    };
+
+    static void add(Counter c, std::uint64_t n) {
+        Block* b = threadBlock;
+        if (b == nullptr) b = registerThread();
+        // 只有本线程写，relaxed 读改写编译为普通加法；其他线程汇总时读到的值不会撕裂
+        b->value[c].store(b->value[c].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    // 当前所有线程的计数之和
+    static Snapshot total();
+    // 清零所有线程的计数与已记录的阶段
+    static void reset();
+    // 每个阶段一行（调用次数 + 各计数器），最后一行为总计；CSV 格式
+    static void report(std::ostream& os);
+
+    static const char* name(Counter c);
+
+    // 作用域内的计数增量记到 name 名下，同名阶段累加
+    class Phase {
+    public:
+        explicit Phase(std::string name);
+        ~Phase();
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        std::string phaseName;
+        Snapshot start;
+    };
+
+private:
+    static Block* registerThread();
+    static inline thread_local Block* threadBlock = nullptr;
+};
+
+#define TRIAL_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define TRIAL_INSTRUMENT_CONCAT(a, b) TRIAL_INSTRUMENT_CONCAT_IMPL(a, b)
+
+#if defined(TRIAL_INSTRUMENT)
+#define TRIAL_COUNT(counter, n) ::Instrument::add(::Instrument::counter, static_cast<std::uint64_t>(n))
+#define TRIAL_PHASE(name) ::Instrument::Phase TRIAL_INSTRUMENT_CONCAT(trialPhase_, __LINE__)(name)
+#else
+#define TRIAL_COUNT(counter, n) ((void)0)
+#define TRIAL_PHASE(name) ((void)0)
+#endif
@@ -11,6 +11,8 @@
 #include "Node.hpp"
 #include "Constants.hpp"
 #include "Utility.hpp"
+#include "AllocProfile.hpp"
+#include "Tracer.hpp"
 
 class ReGraph {
 public:
@@ -62,6 +64,7 @@ public:
 
     template <class G>
     static std::vector<G> reGraphAll(const G& graph) {
+        TRIAL_TRACE_SPAN("ReGraph", "ReGraph::reGraphAll");
         std::vector<G> res;
         Enumerator<G> it(graph);
         G tmp;
@@ -80,6 +83,7 @@ ReGraph::Enumerator<G>::Enumerator(const G& graph) {
         return;
     }
 
+    TRIAL_TRACE_SPAN("ReGraph", "ReGraph::Enumerator");
     Utility::extractGraphInfo(graph, originalAdj_, originalNodes_);
 
     perm_.resize(n_);
@@ -111,6 +115,7 @@ bool ReGraph::Enumerator<G>::nextRandom(G& out) {
     if (n_ <= 0) return false;
 
     if (!randomInitialized_) {
+        TRIAL_TRACE_SPAN("ReGraph", "ReGraph::initRandom");
         totalPerms_ = computeTotalPermutations();
 
         randomTarget_ = static_cast<size_t>(MAX_PERM_NUM);
@@ -241,6 +246,7 @@ uint64_t ReGraph::Enumerator<G>::hashPermutation(const std::vector<Index>& perm)
 
 template <class G>
 bool ReGraph::Enumerator<G>::buildGraphFromPerm(const std::vector<Index>& perm, G& out) {
+    TRIAL_ALLOC_SITE("ReGraph::buildGraphFromPerm");
     std::vector<Index> invrs(n_);
     for (int oldId = 0; oldId < n_; ++oldId) {
         Index newId = perm[oldId];
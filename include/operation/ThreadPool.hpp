@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 常驻线程池：parallelFor 把 [0, count) 按 grain 分块，由各 worker 动态领取；
+// 调用线程本身也作为 worker 0 参与计算，返回时所有分块均已完成。
+// 同一时刻只执行一个 parallelFor；在 worker 内部嵌套调用时直接在当前线程串行执行。
+class ThreadPool {
+public:
+    // threads：总并行度（含调用线程），0 表示 std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // fn(worker, begin, end)：worker ∈ [0, min(size(), maxWorkers))，可用于索引线程私有工作区。
+    // maxWorkers 为 0 表示使用全部 worker。任一分块抛出的异常会在调用线程重新抛出。
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(unsigned, std::size_t, std::size_t)>& fn,
+                     unsigned maxWorkers = 0);
+
+    // 进程级共享实例（首次使用时创建）
+    static ThreadPool& instance();
+
+private:
+    void workerLoop(unsigned id);
+    void runChunks(unsigned id);
+
+    std::vector<std::thread> workers;
+
+    std::mutex submitMutex; // 串行化 parallelFor
+    std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool stopping = false;
+    std::size_t generation = 0;
+
+    // 当前任务
+    const std::function<void(unsigned, std::size_t, std::size_t)>* job = nullptr;
+    std::size_t jobCount = 0;
+    std::size_t jobGrain = 1;
+    unsigned jobWorkers = 0;
+    std::atomic<std::size_t> nextBegin{0};
+    unsigned pending = 0;
+    std::exception_ptr firstError;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 阶段耗时追踪：Span 在作用域内计时，结束时记录一条带线程号的完整事件（Chrome trace 的 "X" 事件），
+// writeJson 输出 Chrome trace JSON，可直接拖入 chrome://tracing 或 Perfetto UI 查看。
+// 运行时开关：start() 之前 / stop() 之后 Span 只做一次原子读，不计时也不分配。
+// 事件按线程缓存，每个线程的缓冲区有自己的互斥量：记录时只取本线程的锁（无竞争），
+// start() / writeJson() / 计数逐个取各缓冲区的锁，因此可以与仍在记录的线程并发调用。
+// 静态名称只保存指针，记录时不分配（动态名称除外）；字符串在 writeJson 时才生成。
+// 每个线程最多缓存 TRACE_MAX_EVENTS_PER_THREAD 条，超出的只计数。
+// 适合阶段级（整图测量、搜索、重构、写文件），不要放进逐节点 / 逐根的内层循环
+class Tracer {
+public:
+    // 清空已记录事件、以当前时刻为时间零点并开始记录
+    static void start();
+    static void stop();
+    static bool active() { return enabled.load(std::memory_order_relaxed); }
+
+    // 为调用线程命名（写入 trace 的 thread_name 元数据）
+    static void setThreadName(const std::string& name);
+
+    // 写出全部已记录事件（与之并发记录的事件可能不包含在内）。打开文件失败时抛出 std::runtime_error
+    static void writeJson(const std::string& path);
+
+    // 当前已记录 / 因超出上限而丢弃的事件数
+    static std::size_t eventCount();
+    static std::size_t droppedCount();
+
+    class Span {
+    public:
+        // category / name 需为字符串字面量等静态存储的字符串
+        Span(const char* category, const char* name);
+        // 动态名称（如带用例标签的阶段名）
+        Span(const char* category, std::string name);
+        ~Span();
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* category;
+        const char* staticName;
+        std::string dynamicName;
+        std::int64_t startNs = -1; // -1：构造时未在记录，析构时忽略
+    };
+
+    struct Event {
+        const char* category;
+        const char* staticName;  // 非空时为名称
+        std::string dynamicName; // staticName 为空时使用
+        std::int64_t startNs;
+        std::int64_t durNs;
+    };
+
+    struct ThreadBuffer {
+        std::mutex mtx; // 保护 events / dropped
+        int tid = 0;
+        std::string name;
+        std::vector<Event> events;
+        std::size_t dropped = 0;
+    };
+
+private:
+    static std::int64_t nowNs();
+    static void record(const char* category, const char* staticName, std::string&& dynamicName,
+                       std::int64_t startNs, std::int64_t endNs);
+    static ThreadBuffer* registerThread();
+
+    static inline std::atomic<bool> enabled{false};
+    static inline thread_local ThreadBuffer* threadBuffer = nullptr;
+};
+
+#define TRIAL_TRACE_CONCAT_IMPL(a, b) a##b
+#define TRIAL_TRACE_CONCAT(a, b) TRIAL_TRACE_CONCAT_IMPL(a, b)
+#define TRIAL_TRACE_SPAN(category, name) ::Tracer::Span TRIAL_TRACE_CONCAT(trialSpan_, __LINE__)(category, name)
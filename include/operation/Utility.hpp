@@ -2,6 +2,8 @@
 
 #include "Graph.hpp"
 #include "MetricsResStorage.hpp"
+#include "StreamingStats.hpp"
+#include <map>
 #include <string>
 
 class Utility {
@@ -13,5 +15,14 @@ public:
     );
     
     static MetricsResStorage doSpaceMeasure(Graph& graph);
+    // 已有结果文件的表头与 saveRes 当前的列不一致时抛出 std::runtime_error；文件为空或不存在视为一致。
+    // 长时间测量前先调用，避免算完才在第一次保存时失败
+    static void checkResHeader(const std::string& path);
+    // 追加写出结果；文件为空或不存在时先写表头。表头不一致时抛出 std::runtime_error（见 checkResHeader）
     static void saveRes(const std::string& path, const MetricsResStorage& res);
+
+    // 逐行读取 saveRes 写出的结果文件，按 label 分组对 colX / colY 两列做单遍相关统计，
+    // 内存只与 label 数有关，与行数无关。文件或列不存在时抛出 std::runtime_error
+    static std::map<std::string, RunningCovariance> correlateResColumns(
+        const std::string& path, const std::string& colX, const std::string& colY);
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+读取 Trial_12（SimilarityMatrix::writeBinary）写出的二进制相似度矩阵（本机字节序）：
+  "SIMMAT02"(8B) | N(uint64) | kind(uint64, 0 = Kendall, 1 = LCS) | layout(uint64) | 数据
+  layout 0：N*N 个 float64（行主序）
+  layout 1：上三角按行压缩，第 i 行为 j = i..N-1，共 N(N+1)/2 个 float64（对称矩阵）
+旧格式 "SIMMAT01"(8B) | N | kind | N*N 个 float64 同样可读。
+
+用法：
+  python read_similarity_matrix.py <matrix.bin>
+打印矩阵规模与非对角元素的统计量；作为模块使用时调用 load_similarity_matrix()。
+"""
+
+import sys
+
+import numpy as np
+
+MAGIC_V1 = b"SIMMAT01"
+MAGIC_V2 = b"SIMMAT02"
+KINDS = {0: "kendall", 1: "lcs"}
+LAYOUT_FULL = 0
+LAYOUT_UPPER = 1
+
+
+def load_similarity_matrix(path: str, mmap: bool = True):
+    """返回 (kind, matrix)，matrix 总是完整的 N×N 矩阵。
+    完整布局且 mmap=True 时以只读内存映射方式打开，适合大矩阵；上三角布局需在内存中镜像为完整矩阵"""
+    with open(path, "rb") as f:
+        magic = f.read(8)
+        if magic == MAGIC_V1:
+            n, kind = np.frombuffer(f.read(16), dtype=np.uint64)
+            layout = LAYOUT_FULL
+        elif magic == MAGIC_V2:
+            n, kind, layout = np.frombuffer(f.read(24), dtype=np.uint64)
+        else:
+            raise ValueError(f"not a similarity matrix file: {path}")
+        offset = f.tell()
+    n = int(n)
+    kind = KINDS.get(int(kind), str(kind))
+
+    if int(layout) == LAYOUT_FULL:
+        if mmap:
+            m = np.memmap(path, dtype=np.float64, mode="r", offset=offset, shape=(n, n))
+        else:
+            m = np.fromfile(path, dtype=np.float64, offset=offset).reshape(n, n)
+        return kind, m
+    if int(layout) != LAYOUT_UPPER:
+        raise ValueError(f"unknown layout {int(layout)} in: {path}")
+
+    packed = np.memmap(path, dtype=np.float64, mode="r", offset=offset, shape=(n * (n + 1) // 2,))
+    m = np.empty((n, n), dtype=np.float64)
+    start = 0
+    for i in range(n):
+        row = packed[start:start + n - i]
+        m[i, i:] = row
+        m[i:, i] = row
+        start += n - i
+    return kind, m
+
+
+def main() -> int:
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+    kind, m = load_similarity_matrix(sys.argv[1])
+    n = m.shape[0]
+    print(f"kind={kind} n={n}")
+    if n >= 2:
+        off = m[~np.eye(n, dtype=bool)]
+        print(f"offdiag: min={off.min():.6f} mean={off.mean():.6f} max={off.max():.6f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
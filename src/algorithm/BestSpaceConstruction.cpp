@@ -65,7 +65,7 @@ static std::size_t dfsPeakFrom(const Graph& g, Index start) {
     if (n <= 0) return 0;
     if (start < 0 || start >= n) return 0;
 
-    // IMPORTANT: keep this consistent with TraversalAlgo::dfs / Metrics::dfsMaxStackFromRoot
+    // IMPORTANT: keep this consistent with TraversalAlgo::dfs / Metrics::measureDFSMaxStack
     // (visited-on-push), otherwise chooseBestRoot() may be misled by an inflated peak.
     std::vector<char> vis(n, false);
     std::stack<Index> st;
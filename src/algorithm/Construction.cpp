@@ -1,5 +1,6 @@
 // Construction.cpp
 #include "Construction.hpp"
+#include "Tracer.hpp"
 
 #include <algorithm>
 #include <queue>
@@ -371,6 +372,7 @@ bool Construction::reorderListForBFS(const AdjListGraph &g,
                                      const std::vector<std::string> &rank,
                                      AdjListGraph &out)
 {
+    TRIAL_TRACE_SPAN("Construction", "Construction::reorderListForBFS");
     const int n = static_cast<int>(g.getNodeCount());
     if (static_cast<int>(rank.size()) != n)
     {
@@ -405,6 +407,7 @@ bool Construction::reorderListForDFS(const AdjListGraph &g,
                                      const std::vector<std::string> &rank,
                                      AdjListGraph &out)
 {
+    TRIAL_TRACE_SPAN("Construction", "Construction::reorderListForDFS");
     const int n = static_cast<int>(g.getNodeCount());
     if (static_cast<int>(rank.size()) != n)
     {
@@ -439,6 +442,7 @@ bool Construction::reorderMatrixForBFS(const AdjMatrixGraph &g,
                                        const std::vector<std::string> &rank,
                                        AdjMatrixGraph &out)
 {
+    TRIAL_TRACE_SPAN("Construction", "Construction::reorderMatrixForBFS");
     const int n = static_cast<int>(g.getNodeCount());
     if (static_cast<int>(rank.size()) != n)
     {
@@ -473,6 +477,7 @@ bool Construction::reorderMatrixForDFS(const AdjMatrixGraph &g,
                                        const std::vector<std::string> &rank,
                                        AdjMatrixGraph &out)
 {
+    TRIAL_TRACE_SPAN("Construction", "Construction::reorderMatrixForDFS");
     const int n = static_cast<int>(g.getNodeCount());
     if (static_cast<int>(rank.size()) != n)
     {
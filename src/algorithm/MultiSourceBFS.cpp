@@ -0,0 +1,139 @@
+#include "MultiSourceBFS.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline unsigned ctz64(std::uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+// 单批次工作区（线程私有，跨批次复用）
+struct BatchWorkspace {
+    std::vector<std::uint64_t> seen;
+    std::vector<std::uint64_t> frontier;
+    std::vector<std::uint64_t> next;
+    std::vector<Index> active;  // 当前边界非空的节点
+    std::vector<Index> touched; // 本层 next 被写过的节点
+};
+
+// 处理 roots[first, first + count)，count <= LANES
+void runBatch(const CsrGraph& g, const std::vector<Index>& roots, std::size_t first, std::size_t count,
+              BatchWorkspace& ws, std::vector<LevelProfile>& out) {
+    const std::size_t n = g.getNodeCount();
+    ws.seen.assign(n, 0);
+    ws.frontier.assign(n, 0);
+    ws.next.assign(n, 0);
+    ws.active.clear();
+    ws.touched.clear();
+
+    for (std::size_t lane = 0; lane < count; ++lane) {
+        const Index r = roots[first + lane];
+        out[first + lane].root = r;
+        out[first + lane].widths.assign(1, 1);
+        const std::uint64_t bit = 1ull << lane;
+        if (ws.frontier[r] == 0) ws.active.push_back(r);
+        ws.seen[r] |= bit;
+        ws.frontier[r] |= bit;
+    }
+
+    std::size_t levelCount[MultiSourceBFS::LANES];
+    while (!ws.active.empty()) {
+        // 推：边界上的根集合沿出边传播到邻居
+        for (Index u : ws.active) {
+            const std::uint64_t f = ws.frontier[u];
+            for (const Index* p = g.neighborsBegin(u); p != g.neighborsEnd(u); ++p) {
+                const Index v = *p;
+                if ((f & ~ws.seen[v]) == 0) continue;
+                if (ws.next[v] == 0) ws.touched.push_back(v);
+                ws.next[v] |= f;
+            }
+            ws.frontier[u] = 0;
+        }
+        ws.active.clear();
+
+        // 收：去掉已到达过的根，形成新边界并按根累计层宽
+        std::fill(levelCount, levelCount + count, 0);
+        for (Index v : ws.touched) {
+            std::uint64_t fresh = ws.next[v] & ~ws.seen[v];
+            ws.next[v] = 0;
+            if (fresh == 0) continue;
+            ws.seen[v] |= fresh;
+            ws.frontier[v] = fresh;
+            ws.active.push_back(v);
+            while (fresh) {
+                ++levelCount[ctz64(fresh)];
+                fresh &= fresh - 1;
+            }
+        }
+        ws.touched.clear();
+
+        for (std::size_t lane = 0; lane < count; ++lane) {
+            if (levelCount[lane] > 0) out[first + lane].widths.push_back(levelCount[lane]);
+        }
+    }
+}
+
+} // namespace
+
+std::size_t LevelProfile::reached() const {
+    std::size_t s = 0;
+    for (std::size_t w : widths) s += w;
+    return s;
+}
+
+std::size_t LevelProfile::peakLowerBound() const {
+    std::size_t lb = 0;
+    for (std::size_t w : widths) lb = std::max(lb, w);
+    return lb;
+}
+
+std::size_t LevelProfile::peakUpperBound() const {
+    std::size_t ub = 0;
+    for (std::size_t d = 0; d < widths.size(); ++d) {
+        const std::size_t nextW = (d + 1 < widths.size()) ? widths[d + 1] : 0;
+        ub = std::max(ub, std::max(widths[d], widths[d] - 1 + nextW));
+    }
+    return ub;
+}
+
+std::vector<LevelProfile> MultiSourceBFS::levelProfiles(const CsrGraph& graph, const std::vector<Index>& roots) {
+    const std::size_t n = graph.getNodeCount();
+    for (Index r : roots) {
+        if (r < 0 || static_cast<std::size_t>(r) >= n) {
+            throw std::invalid_argument("MultiSourceBFS: root out of range");
+        }
+    }
+
+    std::vector<LevelProfile> out(roots.size());
+    const std::size_t batches = (roots.size() + LANES - 1) / LANES;
+    if (batches == 0) return out;
+
+    ThreadPool& pool = ThreadPool::instance();
+    std::vector<BatchWorkspace> ws(pool.size());
+    pool.parallelFor(batches, 1, [&](unsigned w, std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b) {
+            const std::size_t first = b * LANES;
+            runBatch(graph, roots, first, std::min(LANES, roots.size() - first), ws[w], out);
+        }
+    });
+    return out;
+}
+
+std::vector<LevelProfile> MultiSourceBFS::allLevelProfiles(const CsrGraph& graph) {
+    std::vector<Index> roots(graph.getNodeCount());
+    for (std::size_t i = 0; i < roots.size(); ++i) roots[i] = static_cast<Index>(i);
+    return levelProfiles(graph, roots);
+}
@@ -1,5 +1,8 @@
 // RankSeeking.cpp
 #include "RankSeeking.hpp"
+#include "AllocProfile.hpp"
+#include "Instrument.hpp"
+#include "Tracer.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -46,6 +49,7 @@ struct OrderHash {
 
 std::vector<std::vector<std::string>> RankSeeking::getBestRanksForDFS(const Graph& graph)
 {
+    TRIAL_PHASE("RankSeeking::DFS");
     // 内部算法只读 graph，但接口是 Graph&；这里做 const_cast
     auto& g = const_cast<Graph&>(graph);
     return findOptimalOrdersPendingDFS(g, /*maxSolutions*/ 50, /*timeLimitMs*/ 10000);
@@ -53,6 +57,7 @@ std::vector<std::vector<std::string>> RankSeeking::getBestRanksForDFS(const Grap
 
 std::vector<std::vector<std::string>> RankSeeking::getBestRanksForBFS(const Graph& graph)
 {
+    TRIAL_PHASE("RankSeeking::BFS");
     auto& g = const_cast<Graph&>(graph);
     return findOptimalOrdersPendingBFS(g, /*maxSolutions*/ 50, /*timeLimitMs*/ 10000);
 }
@@ -66,6 +71,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingBFS(
     std::size_t maxSolutions,
     std::uint64_t timeLimitMs)
 {
+    TRIAL_TRACE_SPAN("RankSeeking", "RankSeeking::findOptimalOrdersPendingBFS");
     const int n = graph.getNodeCount();
     std::vector<std::vector<std::string>> result;
     if (n <= 0) return result;
@@ -130,6 +136,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingBFS(
         std::function<void(std::uint64_t, std::vector<int>&, std::size_t)> dfs =
             [&](std::uint64_t visited, std::vector<int>& qu, std::size_t peakSoFar) {
                 if (timeout()) return;
+                TRIAL_COUNT(RankStates, 1);
                 // 允许探索 peakSoFar == bestPeak 的分支，以枚举“并列最优”解
                 if (peakSoFar > bestPeak) return;
 
@@ -146,16 +153,22 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingBFS(
                     return;
                 }
 
-                StateKey key{visited, qu};
-                auto it = memo.find(key);
-                // 做“最优值”搜索时可用 >= 剪掉重复状态；但枚举解会丢掉不同前缀。
-                // 因此这里只剪掉“更差”的到达方式：peakSoFar > bestSeen。
-                if (it != memo.end() && peakSoFar > it->second) return;
-                if (it == memo.end()) {
-                    memo.emplace(std::move(key), peakSoFar);
-                } else {
-                    // 保留该状态的最好 peak，用于后续剪枝
-                    it->second = std::min(it->second, peakSoFar);
+                {
+                    TRIAL_ALLOC_SITE("RankSeeking::StateKey");
+                    StateKey key{visited, qu};
+                    auto it = memo.find(key);
+                    // 做“最优值”搜索时可用 >= 剪掉重复状态；但枚举解会丢掉不同前缀。
+                    // 因此这里只剪掉“更差”的到达方式：peakSoFar > bestSeen。
+                    if (it != memo.end() && peakSoFar > it->second) {
+                        TRIAL_COUNT(RankMemoPrunes, 1);
+                        return;
+                    }
+                    if (it == memo.end()) {
+                        memo.emplace(std::move(key), peakSoFar);
+                    } else {
+                        // 保留该状态的最好 peak，用于后续剪枝
+                        it->second = std::min(it->second, peakSoFar);
+                    }
                 }
 
                 int cur = qu.front();
@@ -213,6 +226,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingBFS(
 
                 std::vector<std::vector<int>> perms;
                 if (base.size() <= 7) {
+                    TRIAL_ALLOC_SITE("RankSeeking::sigKey");
                     std::sort(base.begin(), base.end());
                     std::unordered_set<std::string> seenSig;
                     seenSig.reserve(512);
@@ -253,6 +267,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingBFS(
 
                 const std::size_t baseSize = qu.size();
                 for (auto const& perm : perms) {
+                    TRIAL_COUNT(RankBranches, 1);
                     std::uint64_t vmask = visited;
                     std::size_t peak = peakSoFar;
 
@@ -368,6 +383,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingDFS(
     std::size_t maxSolutions,
     std::uint64_t timeLimitMs)
 {
+    TRIAL_TRACE_SPAN("RankSeeking", "RankSeeking::findOptimalOrdersPendingDFS");
     const int n = graph.getNodeCount();
     std::vector<std::vector<std::string>> result;
     if (n <= 0) return result;
@@ -433,6 +449,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingDFS(
         std::function<void(std::uint64_t, std::vector<int>&, std::size_t)> dfs =
             [&](std::uint64_t visited, std::vector<int>& st, std::size_t peakSoFar) {
                 if (timeout()) return;
+                TRIAL_COUNT(RankStates, 1);
                 // 允许探索 peakSoFar == bestPeak 的分支，以枚举“并列最优”解
                 if (peakSoFar > bestPeak) return;
 
@@ -452,14 +469,20 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingDFS(
                 // Path-DFS：峰值下界至少为当前深度（==bestPeak 仍可能是最优解）
                 if (st.size() > bestPeak) return;
 
-                StateKey key{visited, st};
-                auto it = memo.find(key);
-                // 枚举解：不同前缀可能抵达同一(visited,st)。这里只剪掉“更差”的到达方式。
-                if (it != memo.end() && peakSoFar > it->second) return;
-                if (it == memo.end()) {
-                    memo.emplace(std::move(key), peakSoFar);
-                } else {
-                    it->second = std::min(it->second, peakSoFar);
+                {
+                    TRIAL_ALLOC_SITE("RankSeeking::StateKey");
+                    StateKey key{visited, st};
+                    auto it = memo.find(key);
+                    // 枚举解：不同前缀可能抵达同一(visited,st)。这里只剪掉“更差”的到达方式。
+                    if (it != memo.end() && peakSoFar > it->second) {
+                        TRIAL_COUNT(RankMemoPrunes, 1);
+                        return;
+                    }
+                    if (it == memo.end()) {
+                        memo.emplace(std::move(key), peakSoFar);
+                    } else {
+                        it->second = std::min(it->second, peakSoFar);
+                    }
                 }
 
                 int cur = st.back();
@@ -517,6 +540,7 @@ std::vector<std::vector<std::string>> RankSeeking::findOptimalOrdersPendingDFS(
                 });
 
                 for (int v : cand) {
+                    TRIAL_COUNT(RankBranches, 1);
                     st.push_back(v);
                     curOrder.push_back(v);
                     const std::size_t peak2 = std::max<std::size_t>(peakSoFar, st.size());
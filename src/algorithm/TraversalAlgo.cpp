@@ -1,10 +1,182 @@
 #include "TraversalAlgo.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <deque>
+#include <limits>
+#include <utility>
 #include <queue>
 #include <stack>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "Constants.hpp"
+#include "Instrument.hpp"
+
+namespace {
+
+inline unsigned ctz64(std::uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+// 层文件名前缀：进程号 + 进程内序号，多个进程 / 多次调用共用同一 tempDir 时互不冲突
+std::string externalLevelStem() {
+    static std::atomic<unsigned long long> seq{0};
+#if defined(_WIN32)
+    const long long pid = static_cast<long long>(_getpid());
+#else
+    const long long pid = static_cast<long long>(getpid());
+#endif
+    return "ext_bfs_" + std::to_string(pid) + "_" + std::to_string(seq.fetch_add(1));
+}
+
+inline void prefetchRead(const void* p) {
+#if defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    __builtin_prefetch(p, 0, 3);
+#endif
+}
+
+// 处理一个 64 位字：候选位按升序逐个标记 visited 并回调
+template <typename Visit>
+inline void drainWord(std::uint64_t cand, std::size_t w, std::uint64_t* visited, Visit& visit) {
+    visited[w] |= cand;
+    while (cand) {
+        const unsigned b = ctz64(cand);
+        visit(static_cast<Index>((w << 6) | b));
+        cand &= cand - 1;
+    }
+}
+
+// 枚举 row 中所有未访问邻居（升序），并将其标记为已访问。
+// 同一行内的候选互不相同，因此可以先整体计算 cand 再逐位回调。
+template <typename Visit>
+inline void forEachUnvisited(const std::uint64_t* row, std::uint64_t* visited,
+                             std::size_t words, Visit visit) {
+#if defined(__AVX2__)
+    // words 为 4 的倍数（见 BitAdjacency），整块为 0 时一次跳过 256 个候选
+    for (std::size_t w = 0; w < words; w += 4) {
+        const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w));
+        const __m256i vis = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited + w));
+        const __m256i cand = _mm256_andnot_si256(vis, r);
+        if (_mm256_testz_si256(cand, cand)) continue;
+
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), cand);
+        for (std::size_t k = 0; k < 4; ++k) {
+            if (lanes[k]) drainWord(lanes[k], w + k, visited, visit);
+        }
+    }
+#else
+    for (std::size_t w = 0; w < words; ++w) {
+        const std::uint64_t cand = row[w] & ~visited[w];
+        if (cand) drainWord(cand, w, visited, visit);
+    }
+#endif
+}
+
+// 按块顺序写出 Index 序列（外存 BFS 的层文件 / 访问序文件）
+class BlockWriter {
+public:
+    BlockWriter(std::size_t blockElems, ExternalIoStats& io) : io(io) { buf.reserve(blockElems); }
+    ~BlockWriter() { if (fp) std::fclose(fp); }
+
+    void open(const std::string& path) {
+        fp = std::fopen(path.c_str(), "wb");
+        if (fp == nullptr) throw std::runtime_error("Failed to open block file: " + path);
+        buf.clear();
+    }
+    void push(Index v) {
+        buf.push_back(v);
+        if (buf.size() == buf.capacity()) flush();
+    }
+    void close() {
+        if (fp == nullptr) return;
+        flush();
+        const bool ok = std::fclose(fp) == 0;
+        fp = nullptr;
+        if (!ok) throw std::runtime_error("Failed to close block file");
+    }
+
+private:
+    void flush() {
+        if (buf.empty()) return;
+        if (std::fwrite(buf.data(), sizeof(Index), buf.size(), fp) != buf.size()) {
+            throw std::runtime_error("Failed to write block file");
+        }
+        io.bytesWritten += buf.size() * sizeof(Index);
+        ++io.blocksWritten;
+        buf.clear();
+    }
+
+    std::FILE* fp = nullptr;
+    std::vector<Index> buf;
+    ExternalIoStats& io;
+};
+
+// 按块顺序读回 BlockWriter 写出的文件
+class BlockReader {
+public:
+    BlockReader(std::size_t blockElems, ExternalIoStats& io) : blockElems(blockElems), io(io) {}
+    ~BlockReader() { if (fp) std::fclose(fp); }
+
+    void open(const std::string& path) {
+        fp = std::fopen(path.c_str(), "rb");
+        if (fp == nullptr) throw std::runtime_error("Failed to open block file: " + path);
+        buf.clear();
+        pos = 0;
+    }
+    bool next(Index& out) {
+        if (pos == buf.size()) {
+            buf.resize(blockElems);
+            const std::size_t got = std::fread(buf.data(), sizeof(Index), blockElems, fp);
+            buf.resize(got);
+            pos = 0;
+            if (got == 0) return false;
+            io.bytesRead += got * sizeof(Index);
+            ++io.blocksRead;
+        }
+        out = buf[pos++];
+        return true;
+    }
+    void close() {
+        if (fp) std::fclose(fp);
+        fp = nullptr;
+    }
+
+private:
+    std::FILE* fp = nullptr;
+    std::size_t blockElems;
+    std::vector<Index> buf;
+    std::size_t pos = 0;
+    ExternalIoStats& io;
+};
+
+} // namespace
 
 TraversalTrace TraversalAlgo::bfsTrace(Graph& graph) {
     TraversalTrace t;
@@ -18,19 +190,23 @@ TraversalTrace TraversalAlgo::bfsTrace(Graph& graph) {
 
     qu.push(ROOT);
     visited.insert(ROOT);
+    TRIAL_COUNT(Pushes, 1);
     t.parent[static_cast<std::size_t>(ROOT)] = -1;
 
     while (!qu.empty()) {
         Index cur = qu.front();
         qu.pop();
+        TRIAL_COUNT(Pops, 1);
 
         t.order.push_back(cur);
 
         const std::vector<Index> neighbors = graph.getNeighbors(cur);
+        TRIAL_COUNT(VisitedChecks, neighbors.size());
         for (Index adj : neighbors) {
             if (visited.insert(adj).second) { // first time discovered
                 t.parent[static_cast<std::size_t>(adj)] = cur;
                 qu.push(adj);
+                TRIAL_COUNT(Pushes, 1);
             }
         }
     }
@@ -49,22 +225,485 @@ TraversalTrace TraversalAlgo::dfsTrace(Graph& graph) {
 
     st.push(ROOT);
     visited.insert(ROOT);
+    TRIAL_COUNT(Pushes, 1);
     t.parent[static_cast<std::size_t>(ROOT)] = -1;
 
     while (!st.empty()) {
         Index cur = st.top();
         st.pop();
+        TRIAL_COUNT(Pops, 1);
 
         t.order.push_back(cur);
 
         const std::vector<Index> neighbors = graph.getNeighbors(cur);
+        TRIAL_COUNT(VisitedChecks, neighbors.size());
         for (Index adj : neighbors) {
             if (visited.insert(adj).second) { // first time discovered
                 t.parent[static_cast<std::size_t>(adj)] = cur;
                 st.push(adj);
+                TRIAL_COUNT(Pushes, 1);
+            }
+        }
+    }
+    return t;
+}
+
+TraversalTrace TraversalAlgo::bfsTraceBitset(const BitAdjacency& adj) {
+    TraversalTrace t;
+    const int n = static_cast<int>(adj.getNodeCount());
+    if (n <= 0) return t;
+
+    t.parent.assign(n, -1);
+    t.order.reserve(n);
+
+    const std::size_t words = adj.words();
+    std::vector<std::uint64_t> visited(words, 0);
+
+    // order 即 BFS 队列：order[head..] 为尚未出队的节点
+    t.order.push_back(ROOT);
+    visited[static_cast<std::size_t>(ROOT) >> 6] |= 1ull << (static_cast<unsigned>(ROOT) & 63u);
+
+    for (std::size_t head = 0; head < t.order.size(); ++head) {
+        const Index cur = t.order[head];
+        forEachUnvisited(adj.row(cur), visited.data(), words, [&](Index v) {
+            t.parent[static_cast<std::size_t>(v)] = cur;
+            t.order.push_back(v);
+        });
+    }
+    return t;
+}
+
+TraversalTrace TraversalAlgo::dfsTraceBitset(const BitAdjacency& adj) {
+    TraversalTrace t;
+    const int n = static_cast<int>(adj.getNodeCount());
+    if (n <= 0) return t;
+
+    t.parent.assign(n, -1);
+    t.order.reserve(n);
+
+    const std::size_t words = adj.words();
+    std::vector<std::uint64_t> visited(words, 0);
+
+    std::vector<Index> st;
+    st.push_back(ROOT);
+    visited[static_cast<std::size_t>(ROOT) >> 6] |= 1ull << (static_cast<unsigned>(ROOT) & 63u);
+
+    while (!st.empty()) {
+        const Index cur = st.back();
+        st.pop_back();
+
+        t.order.push_back(cur);
+
+        forEachUnvisited(adj.row(cur), visited.data(), words, [&](Index v) {
+            t.parent[static_cast<std::size_t>(v)] = cur;
+            st.push_back(v);
+        });
+    }
+    return t;
+}
+
+TraversalTrace TraversalAlgo::bfsTracePrefetch(const CsrGraph& graph, std::size_t distance) {
+    TraversalTrace t;
+    const int n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0) return t;
+
+    t.parent.assign(n, -1);
+    t.order.reserve(n);
+
+    const std::uint64_t* offsets = graph.offsetData();
+    const Index* targets = graph.targetData();
+    std::vector<uint8_t> visited(n, 0);
+
+    // order 即 BFS 队列：order[head..] 为尚未出队的节点，
+    // 因此“队列中后面第 k 个节点”可以直接按下标取到
+    t.order.push_back(ROOT);
+    visited[ROOT] = 1;
+
+    for (std::size_t head = 0; head < t.order.size(); ++head) {
+        if (distance > 0) {
+            // 两级流水：先取 offsets[u]（2k 处），再取 targets 区间（k 处），
+            // 到达 k 处时 offsets 已在缓存中，计算邻接区间地址本身不会再阻塞
+            const std::size_t far = head + 2 * distance;
+            if (far < t.order.size()) {
+                prefetchRead(offsets + t.order[far]);
+            }
+            const std::size_t near = head + distance;
+            if (near < t.order.size()) {
+                prefetchRead(targets + offsets[t.order[near]]);
+            }
+        }
+
+        const Index cur = t.order[head];
+        const Index* it = targets + offsets[cur];
+        const Index* end = targets + offsets[cur + 1];
+        for (; it != end; ++it) {
+            const Index adj = *it;
+            if (!visited[adj]) {
+                visited[adj] = 1;
+                t.parent[static_cast<std::size_t>(adj)] = cur;
+                t.order.push_back(adj);
+            }
+        }
+    }
+    return t;
+}
+
+TraversalTrace TraversalAlgo::iddfsTrace(Graph& graph, Index root, TraversalCost* cost) {
+    TraversalTrace t;
+    TraversalCost c;
+    const int n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0 || root < 0 || root >= n) {
+        if (cost) *cost = c;
+        return t;
+    }
+
+    t.parent.assign(n, -1);
+
+    const int INF = std::numeric_limits<int>::max();
+    std::vector<uint8_t> seen(n, 0);   // 是否已写入 order（跨轮）
+    std::vector<int> bestDepth(n, INF); // 本轮到达各节点的最小深度
+    // (节点, 下一个待检查的邻居下标)：只保存当前路径
+    std::vector<std::pair<Index, std::size_t>> st;
+    // levelNeighbors[d]：路径上深度 d 的节点的邻居，在该节点入栈展开时取一次，子节点返回后不再重取
+    std::vector<std::vector<Index>> levelNeighbors;
+    c.auxiliary = static_cast<std::size_t>(n);
+
+    seen[root] = 1;
+    t.order.push_back(root);
+
+    for (int limit = 0;; ++limit) {
+        ++c.rounds;
+        std::fill(bestDepth.begin(), bestDepth.end(), INF);
+        if (levelNeighbors.size() < static_cast<std::size_t>(limit)) levelNeighbors.resize(limit);
+
+        st.clear();
+        st.emplace_back(root, 0);
+        bestDepth[root] = 0;
+        c.peak = std::max(c.peak, st.size());
+        if (limit > 0) {
+            levelNeighbors[0] = graph.getNeighbors(root);
+            ++c.expansions;
+        }
+
+        while (!st.empty()) {
+            const Index cur = st.back().first;
+            const int depth = static_cast<int>(st.size()) - 1;
+            if (depth >= limit) {
+                st.pop_back();
+                continue;
+            }
+
+            const std::vector<Index>& neighbors = levelNeighbors[static_cast<std::size_t>(depth)];
+            std::size_t& i = st.back().second;
+            bool pushed = false;
+            while (i < neighbors.size()) {
+                const Index v = neighbors[i++];
+                if (v < 0 || v >= n) continue;
+                if (depth + 1 < bestDepth[v]) {
+                    bestDepth[v] = depth + 1;
+                    if (!seen[v]) {
+                        seen[v] = 1;
+                        t.parent[static_cast<std::size_t>(v)] = cur;
+                        t.order.push_back(v);
+                    }
+                    if (depth + 1 < limit) {
+                        levelNeighbors[static_cast<std::size_t>(depth + 1)] = graph.getNeighbors(v);
+                        ++c.expansions;
+                    }
+                    st.emplace_back(v, 0);
+                    c.peak = std::max(c.peak, st.size());
+                    pushed = true;
+                    break;
+                }
+            }
+            if (!pushed) st.pop_back();
+        }
+
+        // 本轮结束时 bestDepth 即为（不超过 limit 的）最短深度。
+        // 第 limit 层节点没有本轮未到达的邻居，则不存在更深的层，无需再多做一轮
+        bool deeper = false;
+        for (Index v = 0; v < n && !deeper; ++v) {
+            if (bestDepth[v] != limit) continue;
+            ++c.expansions;
+            for (Index w : graph.getNeighbors(v)) {
+                if (w >= 0 && w < n && bestDepth[w] == INF) {
+                    deeper = true;
+                    break;
+                }
+            }
+        }
+        if (!deeper) break;
+    }
+
+    if (cost) *cost = c;
+    return t;
+}
+
+TraversalTrace TraversalAlgo::cappedBfsTrace(Graph& graph, std::size_t budget, Index root, TraversalCost* cost) {
+    TraversalTrace t;
+    TraversalCost c;
+    const int n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0 || root < 0 || root >= n) {
+        if (cost) *cost = c;
+        return t;
+    }
+    budget = std::max<std::size_t>(budget, 1);
+
+    t.parent.assign(n, -1);
+    t.order.reserve(n);
+
+    std::deque<Index> qu;
+    std::vector<uint8_t> visited(n, 0);
+
+    qu.push_back(root);
+    visited[root] = 1;
+    t.order.push_back(root);
+    c.peak = qu.size();
+    c.rounds = 1;
+
+    // order[0..cleanPrefix) 中的节点已没有未访问邻居，重扫时可跳过
+    std::size_t cleanPrefix = 0;
+
+    // 是否可能还有“仍有未访问邻居却不在队列中”的节点
+    bool pending = false;
+    while (true) {
+        while (!qu.empty()) {
+            const Index cur = qu.front();
+            qu.pop_front();
+            ++c.expansions;
+
+            for (Index adj : graph.getNeighbors(cur)) {
+                if (adj < 0 || adj >= n) continue;
+                if (visited[adj]) continue;
+                if (qu.size() >= budget) {
+                    pending = true; // cur 仍有未访问邻居，留待重扫
+                    break;
+                }
+                visited[adj] = 1;
+                t.parent[static_cast<std::size_t>(adj)] = cur;
+                t.order.push_back(adj);
+                qu.push_back(adj);
+                c.peak = std::max(c.peak, qu.size());
+            }
+        }
+        if (!pending) break;
+
+        // 重算：按发现顺序找出仍有未访问邻居的节点，重新入队（不超过 budget）。
+        // 因队列已满而提前结束扫描时，其余节点留待下一轮重扫
+        ++c.rounds;
+        pending = false;
+        bool prefixClean = true;
+        for (std::size_t idx = cleanPrefix; idx < t.order.size(); ++idx) {
+            if (qu.size() >= budget) {
+                pending = true;
+                break;
+            }
+            const Index u = t.order[idx];
+            ++c.expansions;
+            bool dirty = false;
+            for (Index adj : graph.getNeighbors(u)) {
+                if (adj >= 0 && adj < n && !visited[adj]) {
+                    dirty = true;
+                    break;
+                }
+            }
+            if (dirty) {
+                prefixClean = false;
+                qu.push_back(u);
+                c.peak = std::max(c.peak, qu.size());
+            } else if (prefixClean) {
+                cleanPrefix = idx + 1;
+            }
+        }
+    }
+
+    if (cost) *cost = c;
+    return t;
+}
+
+TraversalTrace TraversalAlgo::bfsTraceCompressed(Graph& graph, FrontierStats* stats) {
+    TraversalTrace t;
+    FrontierStats fs;
+    const int n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0) {
+        if (stats) *stats = fs;
+        return t;
+    }
+
+    t.parent.assign(n, -1);
+    t.order.reserve(n);
+
+    const std::size_t words = (static_cast<std::size_t>(n) + 63) / 64;
+    const std::size_t bitmapBytes = words * sizeof(std::uint64_t);
+    std::vector<uint8_t> visited(n, 0);
+
+    // 一层边界：id 列表或位图二选一
+    struct Frontier {
+        bool dense = false;
+        std::vector<Index> list;
+        std::vector<std::uint64_t> bits;
+        std::size_t count = 0;
+
+        std::size_t bytes() const {
+            return list.capacity() * sizeof(Index) + bits.capacity() * sizeof(std::uint64_t);
+        }
+    };
+
+    Frontier cur, next;
+    cur.list.push_back(ROOT);
+    cur.count = 1;
+    visited[ROOT] = 1;
+
+    std::size_t remaining = 1; // 当前层尚未出队的元素数
+    auto observe = [&]() {
+        fs.peakElements = std::max(fs.peakElements, remaining + next.count);
+        fs.peakBytes = std::max(fs.peakBytes, cur.bytes() + next.bytes());
+    };
+    observe();
+
+    auto expand = [&](Index u) {
+        --remaining;
+        t.order.push_back(u);
+        for (Index adj : graph.getNeighbors(u)) {
+            if (adj < 0 || adj >= n) continue;
+            if (visited[adj]) continue;
+            visited[adj] = 1;
+            t.parent[static_cast<std::size_t>(adj)] = u;
+            ++next.count;
+            if (next.dense) {
+                next.bits[static_cast<std::size_t>(adj) >> 6] |= 1ull << (static_cast<unsigned>(adj) & 63u);
+            } else {
+                next.list.push_back(adj);
+                if (next.list.size() * sizeof(Index) > bitmapBytes) {
+                    // 列表比位图更大：转为位图（转换瞬间两者并存，也计入峰值）
+                    next.bits.assign(words, 0);
+                    for (Index v : next.list) {
+                        next.bits[static_cast<std::size_t>(v) >> 6] |= 1ull << (static_cast<unsigned>(v) & 63u);
+                    }
+                    observe();
+                    std::vector<Index>().swap(next.list);
+                    next.dense = true;
+                }
+            }
+            observe();
+        }
+    };
+
+    while (cur.count > 0) {
+        if (cur.dense) {
+            ++fs.bitmapLevels;
+            for (std::size_t w = 0; w < words; ++w) {
+                std::uint64_t x = cur.bits[w];
+                while (x) {
+                    expand(static_cast<Index>((w << 6) | ctz64(x)));
+                    x &= x - 1;
+                }
+            }
+        } else {
+            for (Index u : cur.list) expand(u);
+        }
+
+        cur = std::move(next);
+        next = Frontier();
+        remaining = cur.count;
+    }
+
+    if (stats) *stats = fs;
+    return t;
+}
+
+TraversalTrace TraversalAlgo::bfsTraceExternal(const CsrGraph& graph,
+                                              const ExternalBfsOptions& options,
+                                              ExternalIoStats* io) {
+    TraversalTrace t;
+    ExternalIoStats st;
+    const std::size_t n = graph.getNodeCount();
+    if (n == 0) {
+        if (io) *io = st;
+        return t;
+    }
+
+    if (options.keepTrace) t.parent.assign(n, -1);
+
+    const std::size_t blockElems = std::max<std::size_t>(options.blockBytes / sizeof(Index), 1);
+    std::vector<std::uint64_t> visited((n + 63) / 64, 0);
+    auto testAndSet = [&](Index v) {
+        std::uint64_t& w = visited[static_cast<std::size_t>(v) >> 6];
+        const std::uint64_t mask = 1ull << (static_cast<unsigned>(v) & 63u);
+        if (w & mask) return false;
+        w |= mask;
+        return true;
+    };
+
+    // 两个层文件轮流作为“当前层”与“下一层”
+    namespace fs = std::filesystem;
+    const std::string stamp = externalLevelStem();
+    const std::string levelPath[2] = {
+        (fs::path(options.tempDir) / (stamp + "_0.bin")).string(),
+        (fs::path(options.tempDir) / (stamp + "_1.bin")).string(),
+    };
+    auto cleanup = [&]() {
+        std::error_code ec;
+        fs::remove(levelPath[0], ec);
+        fs::remove(levelPath[1], ec);
+    };
+
+    try {
+        BlockWriter writer(blockElems, st);
+        BlockReader reader(blockElems, st);
+        BlockWriter orderWriter(blockElems, st);
+        const bool writeOrder = !options.orderPath.empty();
+        if (writeOrder) orderWriter.open(options.orderPath);
+
+        int curFile = 0;
+        writer.open(levelPath[curFile]);
+        writer.push(ROOT);
+        writer.close();
+        testAndSet(ROOT);
+        std::size_t levelSize = 1;
+
+        const std::uint64_t* offsets = graph.offsetData();
+        const Index* targets = graph.targetData();
+
+        while (levelSize > 0) {
+            ++st.levels;
+            st.peakLevelSize = std::max(st.peakLevelSize, levelSize);
+
+            reader.open(levelPath[curFile]);
+            writer.open(levelPath[1 - curFile]);
+            std::size_t nextSize = 0;
+
+            Index cur;
+            while (reader.next(cur)) {
+                ++st.visitedCount;
+                if (options.keepTrace) t.order.push_back(cur);
+                if (writeOrder) orderWriter.push(cur);
+
+                const Index* it = targets + offsets[cur];
+                const Index* end = targets + offsets[cur + 1];
+                for (; it != end; ++it) {
+                    const Index adj = *it;
+                    if (testAndSet(adj)) {
+                        if (options.keepTrace) t.parent[static_cast<std::size_t>(adj)] = cur;
+                        writer.push(adj);
+                        ++nextSize;
+                    }
+                }
             }
+            reader.close();
+            writer.close();
+
+            curFile = 1 - curFile;
+            levelSize = nextSize;
         }
+        if (writeOrder) orderWriter.close();
+    } catch (...) {
+        cleanup();
+        throw;
     }
+    cleanup();
+
+    if (io) *io = st;
     return t;
 }
 
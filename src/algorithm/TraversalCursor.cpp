@@ -0,0 +1,84 @@
+#include "TraversalCursor.hpp"
+
+#include <algorithm>
+
+#include "Instrument.hpp"
+
+BFSCursor::BFSCursor(const Graph& graph, Index root) : graph(graph) {
+    n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0 || root < 0 || root >= n) return;
+
+    visited.assign(static_cast<std::size_t>(n), 0);
+    qu.push_back(root);
+    TRIAL_COUNT(Pushes, 1);
+    visited[static_cast<std::size_t>(root)] = 1;
+    maxSize = qu.size();
+}
+
+bool BFSCursor::next(Index& out) {
+    if (qu.empty()) return false;
+
+    Index cur = qu.front();
+    qu.pop_front();
+    TRIAL_COUNT(Pops, 1);
+
+    for (Index adj : graph.getNeighbors(cur)) {
+        if (adj < 0 || adj >= n) continue;
+        TRIAL_COUNT(VisitedChecks, 1);
+        if (!visited[static_cast<std::size_t>(adj)]) {
+            visited[static_cast<std::size_t>(adj)] = 1;
+            qu.push_back(adj);
+            TRIAL_COUNT(Pushes, 1);
+            maxSize = std::max(maxSize, qu.size());
+        }
+    }
+
+    out = cur;
+    return true;
+}
+
+PathDFSCursor::PathDFSCursor(const Graph& graph, Index root) : graph(graph), root(root) {
+    n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0 || root < 0 || root >= n) {
+        started = true; // 空图 / 非法 root：直接视为已结束
+        return;
+    }
+    visited.assign(static_cast<std::size_t>(n), 0);
+}
+
+bool PathDFSCursor::next(Index& out) {
+    if (!started) {
+        started = true;
+        st.emplace_back(root, 0);
+        TRIAL_COUNT(Pushes, 1);
+        visited[static_cast<std::size_t>(root)] = 1;
+        maxSize = st.size();
+        out = root;
+        return true;
+    }
+
+    // 沿当前路径继续：栈顶有未访问邻居则深入一层并产出，否则回溯
+    while (!st.empty()) {
+        Index cur = st.back().first;
+        std::size_t i = st.back().second;
+        auto neigh = graph.getNeighbors(cur);
+
+        while (i < neigh.size()) {
+            Index v = neigh[i++];
+            if (v < 0 || v >= n) continue;
+            TRIAL_COUNT(VisitedChecks, 1);
+            if (!visited[static_cast<std::size_t>(v)]) {
+                st.back().second = i;
+                visited[static_cast<std::size_t>(v)] = 1;
+                st.emplace_back(v, 0);
+                TRIAL_COUNT(Pushes, 1);
+                maxSize = std::max(maxSize, st.size());
+                out = v;
+                return true;
+            }
+        }
+        st.pop_back();
+        TRIAL_COUNT(Pops, 1);
+    }
+    return false;
+}
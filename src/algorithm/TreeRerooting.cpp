@@ -0,0 +1,122 @@
+#include "TreeRerooting.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+bool TreeRerooting::isForest(const std::vector<std::vector<Index>>& adj) {
+    const std::size_t n = adj.size();
+
+    // 森林至多 n - 1 条无向边，多出来的直接排除（稠密图在这里 O(n) 退出）
+    std::size_t directed = 0;
+    for (const auto& nb : adj) directed += nb.size();
+    if (n == 0) return true;
+    if (directed > 2 * (n - 1) || directed % 2 != 0) return false;
+
+    // 反向邻接（计数排序构建），rev[v] 为所有指向 v 的 u
+    std::vector<std::size_t> revOff(n + 1, 0);
+    for (std::size_t u = 0; u < n; ++u) {
+        for (Index v : adj[u]) {
+            if (v < 0 || static_cast<std::size_t>(v) >= n || static_cast<std::size_t>(v) == u) return false;
+            ++revOff[static_cast<std::size_t>(v) + 1];
+        }
+    }
+    for (std::size_t v = 0; v < n; ++v) revOff[v + 1] += revOff[v];
+    std::vector<Index> rev(directed);
+    {
+        std::vector<std::size_t> pos(revOff.begin(), revOff.end() - 1);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (Index v : adj[u]) rev[pos[static_cast<std::size_t>(v)]++] = static_cast<Index>(u);
+        }
+    }
+
+    // 对称且无重边：adj[v] 与 rev[v] 作为集合相等且各自无重复
+    std::vector<std::size_t> stamp(n, static_cast<std::size_t>(-1));
+    for (std::size_t v = 0; v < n; ++v) {
+        if (adj[v].size() != revOff[v + 1] - revOff[v]) return false;
+        for (std::size_t i = revOff[v]; i < revOff[v + 1]; ++i) stamp[static_cast<std::size_t>(rev[i])] = v;
+        for (Index u : adj[v]) {
+            if (stamp[static_cast<std::size_t>(u)] != v) return false; // 不对称或重边
+            stamp[static_cast<std::size_t>(u)] = static_cast<std::size_t>(-2);
+        }
+    }
+
+    // 连通分量计数
+    std::size_t components = 0;
+    std::vector<std::uint8_t> seen(n, 0);
+    std::vector<Index> stack;
+    for (std::size_t s = 0; s < n; ++s) {
+        if (seen[s]) continue;
+        ++components;
+        seen[s] = 1;
+        stack.push_back(static_cast<Index>(s));
+        while (!stack.empty()) {
+            const Index u = stack.back();
+            stack.pop_back();
+            for (Index v : adj[static_cast<std::size_t>(u)]) {
+                if (!seen[static_cast<std::size_t>(v)]) {
+                    seen[static_cast<std::size_t>(v)] = 1;
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+    return directed / 2 == n - components;
+}
+
+std::vector<std::size_t> TreeRerooting::eccentricities(const std::vector<std::vector<Index>>& adj) {
+    const std::size_t n = adj.size();
+    const Index NONE = -1;
+
+    std::vector<Index> parent(n, NONE);
+    std::vector<Index> order; // 各棵树的 BFS 序依次拼接：父节点总在子节点之前
+    order.reserve(n);
+    std::vector<std::uint8_t> seen(n, 0);
+    for (std::size_t s = 0; s < n; ++s) {
+        if (seen[s]) continue;
+        seen[s] = 1;
+        std::size_t head = order.size();
+        order.push_back(static_cast<Index>(s));
+        while (head < order.size()) {
+            const Index u = order[head++];
+            for (Index v : adj[static_cast<std::size_t>(u)]) {
+                if (!seen[static_cast<std::size_t>(v)]) {
+                    seen[static_cast<std::size_t>(v)] = 1;
+                    parent[static_cast<std::size_t>(v)] = u;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+
+    // down1 / down2：经不同孩子向下的最长、次长距离；via1：down1 所经孩子
+    std::vector<std::size_t> down1(n, 0), down2(n, 0);
+    std::vector<Index> via1(n, NONE);
+    for (std::size_t i = n; i-- > 0;) {
+        const Index u = order[i];
+        const Index p = parent[static_cast<std::size_t>(u)];
+        if (p == NONE) continue;
+        const std::size_t d = down1[static_cast<std::size_t>(u)] + 1;
+        const std::size_t pi = static_cast<std::size_t>(p);
+        if (d > down1[pi]) {
+            down2[pi] = down1[pi];
+            down1[pi] = d;
+            via1[pi] = u;
+        } else if (d > down2[pi]) {
+            down2[pi] = d;
+        }
+    }
+
+    // up：离开子树、经父节点能走到的最远距离
+    std::vector<std::size_t> up(n, 0), ecc(n, 0);
+    for (Index u : order) {
+        const std::size_t ui = static_cast<std::size_t>(u);
+        const Index p = parent[ui];
+        if (p != NONE) {
+            const std::size_t pi = static_cast<std::size_t>(p);
+            const std::size_t sibling = (via1[pi] == u) ? down2[pi] : down1[pi];
+            up[ui] = 1 + std::max(up[pi], sibling);
+        }
+        ecc[ui] = std::max(down1[ui], up[ui]);
+    }
+    return ecc;
+}
@@ -1,4 +1,7 @@
 #include "AdjListGraph.hpp"
+#include "AllocProfile.hpp"
+#include "Instrument.hpp"
+#include "Tracer.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -19,6 +22,8 @@ size_t AdjListGraph::getNodeCount() const {
 }
 
 Node AdjListGraph::getNode(Index nodeId) const {
+    TRIAL_COUNT(NodeCopies, 1);
+    TRIAL_ALLOC_SITE("getNode");
     Node res(-1, "none");
     auto it = nodes.find(Node(nodeId));
     if(it != nodes.end()) res = *it;
@@ -80,6 +85,8 @@ bool AdjListGraph::hasEdge(Index from, Index to) const {
 }
 
 std::vector<Index> AdjListGraph::getNeighbors(Index nodeId) const {
+    TRIAL_COUNT(NeighborCalls, 1);
+    TRIAL_ALLOC_SITE("getNeighbors");
     std::vector<Index> res;
 
     // 检查图中有没有该node
@@ -87,6 +94,7 @@ std::vector<Index> AdjListGraph::getNeighbors(Index nodeId) const {
     if(it == nodes.end()) return res;
     
     res = adjList.at(it->index);
+    TRIAL_COUNT(NeighborCopies, res.size());
     return res;
 }
 
@@ -99,6 +107,7 @@ std::string AdjListGraph::getLabel() const {
 }
 
 void AdjListGraph::toCsv(const std::string& path) const {
+    TRIAL_TRACE_SPAN("Storage", "AdjListGraph::toCsv");
     std::ofstream ofs(path);
     if (!ofs.is_open())
     {
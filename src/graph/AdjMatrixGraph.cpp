@@ -1,4 +1,7 @@
 #include "AdjMatrixGraph.hpp"
+#include "AllocProfile.hpp"
+#include "Instrument.hpp"
+#include "Tracer.hpp"
 #include <fstream>
 
 using namespace std;
@@ -29,6 +32,8 @@ size_t AdjMatrixGraph::getNodeCount() const {
 }
 
 Node AdjMatrixGraph::getNode(Index nodeId) const {
+    TRIAL_COUNT(NodeCopies, 1);
+    TRIAL_ALLOC_SITE("getNode");
     Node res(-1, "none");
     auto it = nodes.find(Node(nodeId));
     if(it != nodes.end()) res = *it;
@@ -89,6 +94,8 @@ bool AdjMatrixGraph::hasEdge(Index from, Index to) const {
 }
 
 std::vector<Index> AdjMatrixGraph::getNeighbors(Index nodeId) const {
+    TRIAL_COUNT(NeighborCalls, 1);
+    TRIAL_ALLOC_SITE("getNeighbors");
     std::vector<Index> res;
     
     // 检查图中有没有该node
@@ -103,6 +110,7 @@ std::vector<Index> AdjMatrixGraph::getNeighbors(Index nodeId) const {
             }
         }
     }
+    TRIAL_COUNT(NeighborCopies, res.size());
 
     return res;
 }
@@ -116,6 +124,7 @@ std::string AdjMatrixGraph::getLabel() const {
 }
 
 void AdjMatrixGraph::toCsv(const std::string& path) const {
+    TRIAL_TRACE_SPAN("Storage", "AdjMatrixGraph::toCsv");
     std::ofstream ofs(path);
     if (!ofs.is_open())
     {
@@ -0,0 +1,19 @@
+#include "BitAdjacency.hpp"
+
+BitAdjacency BitAdjacency::fromGraph(const Graph& graph) {
+    BitAdjacency res;
+    res.n = graph.getNodeCount();
+    // 向上取整到 4 个字（256 位）
+    res.wordsPerRow = ((res.n + 255) / 256) * 4;
+    res.bits.assign(res.n * res.wordsPerRow, 0);
+
+    const Index n = static_cast<Index>(res.n);
+    for (Index u = 0; u < n; ++u) {
+        std::uint64_t* row = res.bits.data() + static_cast<size_t>(u) * res.wordsPerRow;
+        for (Index v : graph.getNeighbors(u)) {
+            if (v < 0 || v >= n) continue;
+            row[static_cast<size_t>(v) >> 6] |= 1ull << (static_cast<unsigned>(v) & 63u);
+        }
+    }
+    return res;
+}
@@ -0,0 +1,221 @@
+#include "CsrGraph.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char CSR_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+const size_t CSR_HEADER_BYTES = sizeof(CSR_MAGIC) + 2 * sizeof(std::uint64_t);
+
+struct OwnedStorage {
+    std::vector<std::uint64_t> offsets;
+    std::vector<Index> targets;
+};
+
+// 只读文件映射，析构时解除映射
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open csr file: " + path);
+        }
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz)) {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to stat csr file: " + path);
+        }
+        size = static_cast<size_t>(sz.QuadPart);
+        if (size > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                CloseHandle(file);
+                throw std::runtime_error("Failed to map csr file: " + path);
+            }
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data == nullptr) {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                throw std::runtime_error("Failed to map csr file: " + path);
+            }
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open csr file: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat csr file: " + path);
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                data = nullptr;
+                ::close(fd);
+                throw std::runtime_error("Failed to map csr file: " + path);
+            }
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) ::munmap(data, size);
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* bytes() const { return static_cast<const unsigned char*>(data); }
+    size_t length() const { return size; }
+
+private:
+    void* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+} // namespace
+
+CsrGraph CsrGraph::fromGraph(const Graph& graph) {
+    const Index n = static_cast<Index>(graph.getNodeCount());
+    std::vector<std::vector<Index>> adj(static_cast<size_t>(n));
+    for (Index u = 0; u < n; ++u) {
+        adj[static_cast<size_t>(u)] = graph.getNeighbors(u);
+    }
+    return fromAdjacency(adj);
+}
+
+CsrGraph CsrGraph::fromAdjacency(const std::vector<std::vector<Index>>& adj) {
+    auto owned = std::make_shared<OwnedStorage>();
+    const size_t nodeCount = adj.size();
+    const Index n = static_cast<Index>(nodeCount);
+
+    owned->offsets.assign(nodeCount + 1, 0);
+    for (size_t u = 0; u < nodeCount; ++u) {
+        std::uint64_t deg = 0;
+        for (Index v : adj[u]) {
+            if (v >= 0 && v < n) ++deg;
+        }
+        owned->offsets[u + 1] = owned->offsets[u] + deg;
+    }
+
+    owned->targets.reserve(static_cast<size_t>(owned->offsets[nodeCount]));
+    for (size_t u = 0; u < nodeCount; ++u) {
+        for (Index v : adj[u]) {
+            if (v >= 0 && v < n) owned->targets.push_back(v);
+        }
+    }
+
+    CsrGraph res;
+    res.n = nodeCount;
+    res.m = owned->targets.size();
+    res.offsets = owned->offsets.data();
+    res.targets = owned->targets.data();
+    res.storage = std::move(owned);
+    return res;
+}
+
+void CsrGraph::save(const std::string& path) const {
+    std::FILE* fp = std::fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        throw std::runtime_error("Failed to open csr file: " + path);
+    }
+
+    const std::uint64_t header[2] = {static_cast<std::uint64_t>(n), static_cast<std::uint64_t>(m)};
+    static const std::uint64_t emptyOffset = 0;
+    const std::uint64_t* offsetSrc = offsets ? offsets : &emptyOffset;
+
+    bool ok = std::fwrite(CSR_MAGIC, 1, sizeof(CSR_MAGIC), fp) == sizeof(CSR_MAGIC) &&
+              std::fwrite(header, sizeof(std::uint64_t), 2, fp) == 2 &&
+              std::fwrite(offsetSrc, sizeof(std::uint64_t), n + 1, fp) == n + 1 &&
+              (m == 0 || std::fwrite(targets, sizeof(Index), m, fp) == m);
+    ok = (std::fclose(fp) == 0) && ok;
+    if (!ok) {
+        throw std::runtime_error("Failed to write csr file: " + path);
+    }
+}
+
+CsrGraph CsrGraph::mapFile(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(path);
+    const unsigned char* base = file->bytes();
+    const size_t length = file->length();
+
+    if (length < CSR_HEADER_BYTES || std::memcmp(base, CSR_MAGIC, sizeof(CSR_MAGIC)) != 0) {
+        throw std::runtime_error("Not a csr file: " + path);
+    }
+    std::uint64_t header[2];
+    std::memcpy(header, base + sizeof(CSR_MAGIC), sizeof(header));
+
+    // 先按文件长度约束 n / m，再计算期望长度，避免恶意头部使乘法溢出后通过截断检查
+    const std::uint64_t payload = static_cast<std::uint64_t>(length - CSR_HEADER_BYTES);
+    if (header[0] > static_cast<std::uint64_t>(std::numeric_limits<Index>::max()) ||
+        header[0] >= payload / sizeof(std::uint64_t)) {
+        throw std::runtime_error("Truncated csr file: " + path);
+    }
+    const size_t n = static_cast<size_t>(header[0]);
+    const std::uint64_t targetBytes = payload - (header[0] + 1) * sizeof(std::uint64_t);
+    if (header[1] > targetBytes / sizeof(Index)) {
+        throw std::runtime_error("Truncated csr file: " + path);
+    }
+    const size_t m = static_cast<size_t>(header[1]);
+
+    // 遍历内核不做越界检查，映射时一次顺序扫描校验结构：
+    // offsets[0] == 0、单调不减、offsets[n] == m，且每个 target 在 [0, n) 内
+    const std::uint64_t* offsets = reinterpret_cast<const std::uint64_t*>(base + CSR_HEADER_BYTES);
+    const Index* targets = reinterpret_cast<const Index*>(base + CSR_HEADER_BYTES + (n + 1) * sizeof(std::uint64_t));
+    if (offsets[0] != 0 || offsets[n] != m) {
+        throw std::runtime_error("Corrupt csr offsets: " + path);
+    }
+    for (size_t u = 0; u < n; ++u) {
+        if (offsets[u + 1] < offsets[u]) {
+            throw std::runtime_error("Corrupt csr offsets: " + path);
+        }
+    }
+    const Index nodeCount = static_cast<Index>(n);
+    for (size_t i = 0; i < m; ++i) {
+        if (targets[i] < 0 || targets[i] >= nodeCount) {
+            throw std::runtime_error("Corrupt csr targets: " + path);
+        }
+    }
+
+    CsrGraph res;
+    res.n = n;
+    res.m = m;
+    res.mapped = true;
+    res.offsets = offsets;
+    res.targets = targets;
+    res.storage = std::move(file);
+    return res;
+}
@@ -0,0 +1,292 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace
+{
+    // 已排序样本的线性插值分位数
+    double sortedPercentile(const std::vector<double> &sorted, double q)
+    {
+        if (sorted.empty())
+            return 0.0;
+        q = std::min(1.0, std::max(0.0, q));
+        const double pos = q * static_cast<double>(sorted.size() - 1);
+        const std::size_t lo = static_cast<std::size_t>(std::floor(pos));
+        const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+        const double frac = pos - static_cast<double>(lo);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+    }
+
+#if !defined(__GNUC__) && !defined(__clang__)
+    const void *volatile benchSink = nullptr;
+#endif
+}
+
+#if !defined(__GNUC__) && !defined(__clang__)
+void Benchmark::sinkAddress(const void *p)
+{
+    benchSink = p;
+}
+#endif
+
+double BenchSummary::percentile(double q) const
+{
+    std::vector<double> sorted = sampleNs;
+    std::sort(sorted.begin(), sorted.end());
+    return sortedPercentile(sorted, q);
+}
+
+BenchSummary Benchmark::summarize(std::string name, std::vector<double> sampleNs, std::size_t itersPerSample)
+{
+    BenchSummary s;
+    s.name = std::move(name);
+    s.itersPerSample = itersPerSample;
+    s.sampleNs = std::move(sampleNs);
+    if (s.sampleNs.empty())
+        return s;
+
+    std::vector<double> sorted = s.sampleNs;
+    std::sort(sorted.begin(), sorted.end());
+    s.min = sorted.front();
+    s.max = sorted.back();
+    s.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    s.median = sortedPercentile(sorted, 0.5);
+
+    std::vector<double> dev(sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+        dev[i] = std::fabs(sorted[i] - s.median);
+    std::sort(dev.begin(), dev.end());
+    s.mad = sortedPercentile(dev, 0.5);
+    return s;
+}
+
+bool Benchmark::pinCurrentThread(int cpu)
+{
+    if (cpu < 0)
+        return false;
+#if defined(_WIN32)
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+        return false;
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// 预热 warmupMs，同时把迭代次数翻倍直到一批的耗时达到 minSampleNs
+void Benchmark::warmupAndCalibrate(Case &c) const
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    std::size_t iters = 1;
+    for (;;)
+    {
+        const double ns = c.runBatch(iters);
+        const double warmedMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (ns >= opt.minSampleNs || iters >= opt.maxIters)
+        {
+            if (warmedMs >= opt.warmupMs)
+                break;
+            continue; // 批大小已够，继续预热
+        }
+        // 按本批耗时估计所需倍数（至少翻倍），避免在很快的函数上校准过久
+        const double scale = (ns > 0.0) ? opt.minSampleNs / ns : 10.0;
+        const double grow = std::min(10.0, std::max(2.0, scale));
+        iters = std::min(opt.maxIters, static_cast<std::size_t>(static_cast<double>(iters) * grow));
+    }
+    c.iters = iters;
+}
+
+std::vector<BenchSummary> Benchmark::run()
+{
+    if (opt.pinCpu >= 0)
+        pinCurrentThread(opt.pinCpu);
+
+    for (Case &c : cases)
+    {
+        c.samples.clear();
+        c.samples.reserve(opt.samples);
+        warmupAndCalibrate(c);
+    }
+
+    std::unique_ptr<PerfCounters> perf;
+    perfStatusText.clear();
+    if (opt.perfCounters)
+    {
+        perf.reset(new PerfCounters());
+        perfStatusText = perf->status();
+        if (!perf->available())
+            perf.reset();
+    }
+
+    std::mt19937 rng(opt.seed);
+    std::vector<std::size_t> order(cases.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (std::size_t round = 0; round < opt.samples; ++round)
+    {
+        if (opt.interleave)
+            std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t idx : order)
+        {
+            Case &c = cases[idx];
+            if (perf)
+                perf->start();
+            const double ns = c.runBatch(c.iters);
+            if (perf)
+                c.counterSum.accumulate(perf->stop());
+            c.samples.push_back(ns / static_cast<double>(c.iters));
+        }
+    }
+
+    std::vector<BenchSummary> res;
+    res.reserve(cases.size());
+    for (Case &c : cases)
+    {
+        const double totalIters = static_cast<double>(c.iters) * static_cast<double>(c.samples.size());
+        res.push_back(summarize(c.name, std::move(c.samples), c.iters));
+        res.back().counters = c.counterSum.per(totalIters);
+        c.counterSum = PerfCounts();
+    }
+    return res;
+}
+
+void Benchmark::writeCsv(const std::string &path, const std::vector<BenchSummary> &results)
+{
+    std::ofstream ofs(path);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error("Failed to open csv file: " + path);
+    }
+
+    // header
+    ofs << "name,itersPerSample,samples,medianNs,madNs,meanNs,minNs,maxNs,p05Ns,p95Ns";
+    for (int e = 0; e < PerfCounts::EventCount; ++e)
+        ofs << ',' << PerfCounts::name(static_cast<PerfCounts::Event>(e));
+    ofs << ",ipc\n";
+    ofs << std::setprecision(10);
+
+    for (const BenchSummary &s : results)
+    {
+        ofs << s.name << ',' << s.itersPerSample << ',' << s.sampleNs.size() << ','
+            << s.median << ',' << s.mad << ',' << s.mean << ',' << s.min << ',' << s.max << ','
+            << s.percentile(0.05) << ',' << s.percentile(0.95);
+        for (int e = 0; e < PerfCounts::EventCount; ++e)
+        {
+            ofs << ',';
+            if (s.counters.has(static_cast<PerfCounts::Event>(e)))
+                ofs << s.counters.value[e];
+        }
+        ofs << ',';
+        if (s.counters.ipc() >= 0.0)
+            ofs << s.counters.ipc();
+        ofs << '\n';
+    }
+}
+
+ThroughputResult Benchmark::measureThroughput(const std::function<std::function<void()>(unsigned)> &makeWorker,
+                                              const ThroughputOptions &options)
+{
+    using Clock = std::chrono::steady_clock;
+    const unsigned k = std::max(1u, options.threads);
+
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    ConcurrentHistogram latency; // 各线程写自己的分片，互不共享缓存行
+    std::vector<LatencyHistogram> perThread(k);
+    std::vector<Clock::time_point> finish(k);
+    std::vector<std::exception_ptr> errors(k);
+
+    std::vector<std::thread> threads;
+    threads.reserve(k);
+    for (unsigned t = 0; t < k; ++t)
+    {
+        threads.emplace_back([&, t]
+                             {
+            bool signalled = false; // 本线程是否已计入 ready（每个线程只计一次）
+            try
+            {
+                if (options.pinBase >= 0)
+                    pinCurrentThread(options.pinBase + static_cast<int>(t));
+                std::function<void()> op = makeWorker(t);
+                LatencyHistogram &hist = latency.local();
+                ready.fetch_add(1);
+                signalled = true;
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const auto t0 = Clock::now();
+                    op();
+                    clobberMemory();
+                    const auto t1 = Clock::now();
+                    hist.record(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+                }
+                perThread[t] = hist;
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+                if (!signalled)
+                    ready.fetch_add(1);
+            }
+            finish[t] = Clock::now(); });
+    }
+
+    // 全部线程准备好（私有副本已构造）后同时开始
+    while (ready.load() < k)
+        std::this_thread::yield();
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(options.durationMs));
+    stop.store(true);
+    for (std::thread &th : threads)
+        th.join();
+    for (const std::exception_ptr &e : errors)
+    {
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+    ThroughputResult res;
+    res.threads = k;
+    auto last = start;
+    for (unsigned t = 0; t < k; ++t)
+    {
+        last = std::max(last, finish[t]);
+        res.totalOps += static_cast<std::size_t>(perThread[t].count());
+    }
+    res.perThread = std::move(perThread);
+    res.latency = latency.merged();
+    res.seconds = std::chrono::duration<double>(last - start).count();
+    res.opsPerSec = (res.seconds > 0.0) ? static_cast<double>(res.totalOps) / res.seconds : 0.0;
+    return res;
+}
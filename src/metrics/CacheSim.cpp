@@ -0,0 +1,76 @@
+#include "CacheSim.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    bool isPowerOfTwo(std::size_t x)
+    {
+        return x != 0 && (x & (x - 1)) == 0;
+    }
+}
+
+CacheSim::CacheSim(const CacheConfig &config)
+{
+    if (config.lineBytes == 0 || config.ways == 0 || config.sizeBytes == 0 || !isPowerOfTwo(config.lineBytes))
+    {
+        throw std::invalid_argument("CacheSim: line size must be a power of two and all sizes non-zero");
+    }
+    const std::size_t lineCount = config.sizeBytes / config.lineBytes;
+    if (lineCount * config.lineBytes != config.sizeBytes || lineCount % config.ways != 0 ||
+        !isPowerOfTwo(lineCount / config.ways))
+    {
+        throw std::invalid_argument("CacheSim: size / (line * ways) must be a power of two");
+    }
+
+    while ((std::size_t(1) << lineShift) < config.lineBytes)
+        ++lineShift;
+    setMask = lineCount / config.ways - 1;
+    ways = config.ways;
+    tags.assign(lineCount, 0);
+    stamp.assign(lineCount, 0);
+}
+
+void CacheSim::reset()
+{
+    std::fill(tags.begin(), tags.end(), 0);
+    std::fill(stamp.begin(), stamp.end(), 0);
+    clock = 0;
+    counters = CacheStats();
+}
+
+void CacheSim::access(std::uint64_t addr, std::size_t bytes)
+{
+    if (bytes == 0)
+        return;
+    const std::uint64_t first = addr >> lineShift;
+    const std::uint64_t last = (addr + bytes - 1) >> lineShift;
+    for (std::uint64_t line = first; line <= last; ++line)
+    {
+        ++counters.accesses;
+        ++clock;
+        const std::size_t base = static_cast<std::size_t>(line & setMask) * ways;
+        const std::uint64_t tag = line + 1;
+
+        std::size_t victim = base;
+        bool hit = false;
+        for (std::size_t w = base; w < base + ways; ++w)
+        {
+            if (tags[w] == tag)
+            {
+                stamp[w] = clock;
+                hit = true;
+                break;
+            }
+            if (stamp[w] < stamp[victim])
+                victim = w;
+        }
+        if (hit)
+            continue;
+
+        ++counters.misses;
+        tags[victim] = tag;
+        stamp[victim] = clock;
+    }
+}
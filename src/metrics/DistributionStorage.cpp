@@ -1,6 +1,9 @@
 #include "DistributionStorage.hpp"
+#include "AllocProfile.hpp"
+#include "Tracer.hpp"
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -22,12 +25,14 @@ unsigned long long DistributionStorage::size()
 
 void DistributionStorage::insert(vector<string> accessRank, size_t maxSize)
 {
+    TRIAL_ALLOC_SITE("DistributionStorage::insert");
     distribution[maxSize].push_back(accessRank);
     accessRankNum += 1;
 }
 
 void DistributionStorage::toCsv(const std::string &path) const
 {
+    TRIAL_TRACE_SPAN("Storage", "DistributionStorage::toCsv");
     std::ofstream ofs(path);
     if (!ofs.is_open())
     {
@@ -62,4 +67,57 @@ void DistributionStorage::toCsv(const std::string &path) const
     }
 
     ofs.close();
-}
\ No newline at end of file
+}
+
+DistributionStorage DistributionStorage::fromCsv(const std::string &path)
+{
+    TRIAL_TRACE_SPAN("Storage", "DistributionStorage::fromCsv");
+    std::ifstream ifs(path);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error("Failed to open csv file: " + path);
+    }
+
+    DistributionStorage res;
+    string line;
+    getline(ifs, line); // header
+    while (getline(ifs, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+
+        const size_t c1 = line.find(',');
+        const size_t c2 = (c1 == string::npos) ? string::npos : line.find(',', c1 + 1);
+        if (c2 == string::npos)
+        {
+            throw std::runtime_error("Malformed distribution csv line in: " + path);
+        }
+        const size_t key = static_cast<size_t>(std::stoull(line.substr(0, c1)));
+
+        string items = line.substr(c2 + 1);
+        if (items.size() >= 2 && items.front() == '"' && items.back() == '"')
+            items = items.substr(1, items.size() - 2);
+
+        // 与 toCsv 对应：访问秩之间以 " | " 分隔，访问秩内以 ';' 分隔
+        size_t start = 0;
+        while (start <= items.size())
+        {
+            size_t stop = items.find(" | ", start);
+            if (stop == string::npos)
+                stop = items.size();
+
+            vector<string> rank;
+            stringstream ss(items.substr(start, stop - start));
+            string item;
+            while (getline(ss, item, ';'))
+                rank.push_back(item);
+            if (!rank.empty())
+                res.insert(rank, key);
+
+            start = stop + 3;
+        }
+    }
+    return res;
+}
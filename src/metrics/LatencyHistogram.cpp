@@ -0,0 +1,137 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    constexpr std::uint64_t SUB_COUNT = std::uint64_t(1) << LatencyHistogram::PRECISION_BITS;
+
+    inline unsigned msb64(std::uint64_t x)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse64(&idx, x);
+        return static_cast<unsigned>(idx);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#endif
+    }
+
+    std::atomic<std::uint64_t> nextHistogramId{1};
+}
+
+// v < 2S：下标即值；否则 e = msb(v) - p，下标 = e * S + (v >> e)，(v >> e) ∈ [S, 2S)
+std::size_t LatencyHistogram::indexOf(std::uint64_t value)
+{
+    if (value < 2 * SUB_COUNT)
+        return static_cast<std::size_t>(value);
+    const unsigned e = msb64(value) - PRECISION_BITS;
+    return static_cast<std::size_t>(e * SUB_COUNT + (value >> e));
+}
+
+std::uint64_t LatencyHistogram::lowerOf(std::size_t index)
+{
+    if (index < 2 * SUB_COUNT)
+        return index;
+    const std::uint64_t e = index / SUB_COUNT - 1;
+    const std::uint64_t sub = index - e * SUB_COUNT;
+    return sub << e;
+}
+
+std::uint64_t LatencyHistogram::upperOf(std::size_t index)
+{
+    if (index < 2 * SUB_COUNT)
+        return index;
+    const std::uint64_t e = index / SUB_COUNT - 1;
+    const std::uint64_t sub = index - e * SUB_COUNT;
+    return (sub << e) + ((std::uint64_t(1) << e) - 1);
+}
+
+void LatencyHistogram::recordN(std::uint64_t value, std::uint64_t count)
+{
+    if (count == 0)
+        return;
+    const std::size_t idx = indexOf(value);
+    if (idx >= counts.size())
+        counts.resize(idx + 1, 0);
+    counts[idx] += count;
+    total += count;
+    lo = std::min(lo, value);
+    hi = std::max(hi, value);
+    sum += static_cast<double>(value) * static_cast<double>(count);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    if (other.total == 0)
+        return;
+    if (other.counts.size() > counts.size())
+        counts.resize(other.counts.size(), 0);
+    for (std::size_t i = 0; i < other.counts.size(); ++i)
+        counts[i] += other.counts[i];
+    total += other.total;
+    lo = std::min(lo, other.lo);
+    hi = std::max(hi, other.hi);
+    sum += other.sum;
+}
+
+void LatencyHistogram::clear()
+{
+    counts.clear();
+    total = 0;
+    lo = UINT64_MAX;
+    hi = 0;
+    sum = 0.0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const
+{
+    if (total == 0)
+        return 0;
+    q = std::min(1.0, std::max(0.0, q));
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            const std::uint64_t mid = lowerOf(i) + (upperOf(i) - lowerOf(i)) / 2;
+            return std::min(hi, std::max(lo, mid));
+        }
+    }
+    return hi;
+}
+
+ConcurrentHistogram::ConcurrentHistogram() : id(nextHistogramId.fetch_add(1)) {}
+
+LatencyHistogram &ConcurrentHistogram::local()
+{
+    thread_local std::unordered_map<std::uint64_t, LatencyHistogram *> mine;
+    auto it = mine.find(id);
+    if (it != mine.end())
+        return *it->second;
+
+    std::lock_guard<std::mutex> lk(mtx);
+    shards.push_back(std::unique_ptr<LatencyHistogram>(new LatencyHistogram()));
+    LatencyHistogram *h = shards.back().get();
+    mine.emplace(id, h);
+    return *h;
+}
+
+LatencyHistogram ConcurrentHistogram::merged() const
+{
+    LatencyHistogram res;
+    std::lock_guard<std::mutex> lk(mtx);
+    for (const auto &h : shards)
+        res.merge(*h);
+    return res;
+}
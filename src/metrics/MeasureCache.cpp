@@ -0,0 +1,173 @@
+#include "MeasureCache.hpp"
+#include "AllocProfile.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+    inline uint64_t mix64(uint64_t x)
+    {
+        // splitmix64 终混
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+}
+
+size_t MeasureCache::KeyHash::operator()(const Key &k) const noexcept
+{
+    const uint64_t h = (static_cast<uint64_t>(k.structure) << 32) | k.root;
+    return static_cast<size_t>(mix64(h ^ (k.algo == Algo::DFS ? 0x5bd1e995ull : 0ull)));
+}
+
+size_t MeasureCache::SequenceHash::operator()(const vector<uint32_t> &s) const noexcept
+{
+    // 只用于分桶，相等性由 vector 的 == 精确判断
+    uint64_t h = s.size();
+    for (uint32_t x : s)
+        h = mix64(h ^ x);
+    return static_cast<size_t>(h);
+}
+
+MeasureCache::MeasureCache(size_t maxEntries) : maxEntries(maxEntries)
+{
+}
+
+MeasureCache::Structure MeasureCache::structureOf(const Graph &graph)
+{
+    Structure st;
+    if (!enabled)
+        return st;
+
+    TRIAL_ALLOC_SITE("MeasureCache::structureOf");
+    st.serial = ++lastSerial;
+    const Index n = static_cast<Index>(graph.getNodeCount());
+    nodeLabel.resize(static_cast<size_t>(n));
+    for (Index v = 0; v < n; ++v)
+    {
+        const auto ins = labelIds.emplace(graph.getNode(v).label, static_cast<uint32_t>(labelIds.size()));
+        nodeLabel[v] = ins.first->second;
+    }
+
+    byLabel.resize(static_cast<size_t>(n));
+    for (Index v = 0; v < n; ++v)
+        byLabel[v] = v;
+    sort(byLabel.begin(), byLabel.end(), [this](Index a, Index b)
+         { return nodeLabel[a] < nodeLabel[b]; });
+    for (Index i = 1; i < n; ++i)
+    {
+        if (nodeLabel[byLabel[i]] == nodeLabel[byLabel[i - 1]])
+            return st; // 重复标签：根标签不能确定根，不缓存
+    }
+
+    // 规范序列：按标签 id 升序，每个节点依次为 标签 id、邻居数、有序邻居标签 id
+    sequence.clear();
+    for (Index v : byLabel)
+    {
+        sequence.push_back(nodeLabel[v]);
+        const size_t degAt = sequence.size();
+        sequence.push_back(0);
+        for (Index u : graph.getNeighbors(v))
+        {
+            if (u < 0 || u >= n)
+                continue;
+            sequence.push_back(nodeLabel[u]);
+        }
+        sequence[degAt] = static_cast<uint32_t>(sequence.size() - degAt - 1);
+    }
+
+    auto it = structures.find(sequence);
+    if (it == structures.end())
+    {
+        if (entries.size() >= maxEntries || structures.size() >= maxEntries)
+            return st; // 已满：新结构不再缓存
+        it = structures.emplace(sequence, static_cast<uint32_t>(structures.size())).first;
+    }
+    st.id = it->second;
+    st.cacheable = true;
+    return st;
+}
+
+size_t MeasureCache::measureDirect(Graph &graph, Index root, Algo algo, vector<string> &order)
+{
+    return (algo == Algo::DFS) ? Metrics::measureDFSMaxStackFromRoot(graph, order, root)
+                               : Metrics::measureBFSMaxQueueFromRoot(graph, order, root);
+}
+
+size_t MeasureCache::measure(Graph &graph, const Structure &structure, Index root, Algo algo,
+                             vector<string> &order)
+{
+    if (!enabled || !structure.cacheable)
+    {
+        ++bypassCount;
+        return measureDirect(graph, root, algo, order);
+    }
+
+    TRIAL_ALLOC_SITE("MeasureCache::measure");
+    uint32_t rootLabel;
+    if (structure.serial == lastSerial && root >= 0 && static_cast<size_t>(root) < nodeLabel.size())
+    {
+        rootLabel = nodeLabel[root];
+    }
+    else
+    {
+        // structure 不是最近一次 structureOf 的结果：按标签查 id
+        auto it = labelIds.find(graph.getNode(root).label);
+        if (it == labelIds.end())
+        {
+            ++bypassCount;
+            return measureDirect(graph, root, algo, order);
+        }
+        rootLabel = it->second;
+    }
+
+    const Key key{structure.id, rootLabel, algo};
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        ++hitCount;
+        order = it->second.order;
+        return it->second.space;
+    }
+
+    ++missCount;
+    const size_t space = measureDirect(graph, root, algo, order);
+
+    // 探测期后累计命中率仍低：停用并释放缓存，后续直接测量
+    if (hitCount + missCount >= MEASURE_CACHE_PROBE && hitRate() < MEASURE_CACHE_MIN_HIT_RATE)
+    {
+        enabled = false;
+        entries = unordered_map<Key, Entry, KeyHash>();
+        structures = unordered_map<vector<uint32_t>, uint32_t, SequenceHash>();
+        labelIds = unordered_map<string, uint32_t>();
+        nodeLabel = vector<uint32_t>();
+        byLabel = vector<Index>();
+        sequence = vector<uint32_t>();
+        return space;
+    }
+
+    if (entries.size() < maxEntries)
+        entries.emplace(key, Entry{space, order});
+    return space;
+}
+
+double MeasureCache::hitRate() const
+{
+    const size_t total = hitCount + missCount;
+    return total == 0 ? 0.0 : static_cast<double>(hitCount) / static_cast<double>(total);
+}
+
+void MeasureCache::clear()
+{
+    entries.clear();
+    structures.clear();
+    labelIds.clear();
+    enabled = true;
+    hitCount = 0;
+    missCount = 0;
+    bypassCount = 0;
+}
@@ -1,15 +1,40 @@
 #include "Metrics.hpp"
 #include "Constants.hpp"
+#include "CountingAllocator.hpp"
+#include "Instrument.hpp"
+#include "MultiSourceBFS.hpp"
+#include "OccupancyTimeline.hpp"
+#include "StreamingStats.hpp"
+#include "ThreadPool.hpp"
+#include "Tracer.hpp"
+#include "TreeRerooting.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <deque>
 #include <queue>
+#include <random>
 #include <stack>
 #include <unordered_set>
 #include <unordered_map>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace
 {
+    static inline std::size_t popcount64(uint64_t x)
+    {
+#if defined(_MSC_VER)
+        return static_cast<std::size_t>(__popcnt64(x));
+#else
+        return static_cast<std::size_t>(__builtin_popcountll(x));
+#endif
+    }
+
     // 存储图中节点度的相关信息, 用于判断是否存在大度节点
     struct DegreeStats
     {
@@ -17,32 +42,17 @@ namespace
         double std = 0.0;
     };
 
-    // 统计图中节点度的相关信息
+    // 统计图中节点度的相关信息（单遍，不保存度序列）
     static DegreeStats degreeStats(const Graph &g)
     {
-        DegreeStats s;
         const int n = static_cast<int>(g.getNodeCount());
-        if (n <= 0)
-            return s;
-
-        std::vector<double> deg(n, 0.0);
-        double sum = 0.0;
+        RunningStats rs;
         for (int v = 0; v < n; ++v)
-        {
-            double d = static_cast<double>(g.getNeighbors(v).size());
-            deg[v] = d;
-            sum += d;
-        }
-        s.mean = sum / n;
+            rs.push(static_cast<double>(g.getNeighbors(v).size()));
 
-        double var = 0.0;
-        for (int v = 0; v < n; ++v)
-        {
-            double x = deg[v] - s.mean;
-            var += x * x;
-        }
-        var /= n; // 总体方差
-        s.std = std::sqrt(var);
+        DegreeStats s;
+        s.mean = rs.mean();
+        s.std = rs.stddev(); // 总体标准差
         return s;
     }
 
@@ -136,57 +146,829 @@ namespace
         return w;
     }
 
-} // anonymous namespace
 
-// Metrics.cpp
+    // 度数 Top-K 节点（K = ceil(sqrt(n))，至少 2，至多 n），dv 为 degreesWithId 的结果
+    static std::vector<int> topDegreeNodes(const std::vector<std::pair<int, int>> &dv)
+    {
+        const int n = static_cast<int>(dv.size());
+        int K = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n))));
+        K = std::max(2, K);
+        K = std::min(K, n);
+
+        std::vector<int> top;
+        top.reserve(static_cast<std::size_t>(K));
+        for (int i = 0; i < K; ++i)
+            top.push_back(dv[static_cast<std::size_t>(i)].second);
+        return top;
+    }
 
-std::size_t Metrics::dfsMaxStackFromRoot(Graph &graph, Index root)
-{
-    const int n = graph.getNodeCount();
-    if (n == 0)
-        return 0;
+    // 大度节点间距：Top-K 大度节点访问秩之间的间隔与均匀间隔 (n-1)/(K-1) 的归一化偏差
+    static double highDegreeSpacingOnPos(const std::vector<int> &pos, const std::vector<int> &top)
+    {
+        const int n = static_cast<int>(pos.size());
+        std::vector<int> p;
+        p.reserve(top.size());
+        for (int v : top)
+        {
+            int pv = pos[static_cast<std::size_t>(v)];
+            if (pv >= 0)
+                p.push_back(pv); // 非连通时可能 -1，跳过
+        }
 
-    // Path-DFS（标准 DFS）：栈表示“当前路径”。
-    // 这里度量的是路径栈 st 的峰值（等价于递归 DFS 的最大递归深度）。
-    std::stack<Index> st;
-    std::vector<uint8_t> visited(n, 0);
-    std::vector<std::size_t> nextIdx(static_cast<std::size_t>(n), 0);
+        if (p.size() < 2)
+            return -1.0; // 无法计算间距
 
-    std::size_t maxSize = 0;
+        std::sort(p.begin(), p.end());
 
-    st.push(root);
-    visited[root] = 1; // 标准 DFS：发现即标记
-    maxSize = std::max(maxSize, st.size());
+        const int K2 = static_cast<int>(p.size());
+        const double deltaStar = static_cast<double>(n - 1) / static_cast<double>(K2 - 1);
+        if (deltaStar <= 0.0)
+            return 1.0; // 退化情况，视为“最好”
 
-    while (!st.empty())
+        double sumAbs = 0.0;
+        for (int i = 0; i + 1 < K2; ++i)
+        {
+            const int delta = p[i + 1] - p[i];
+            // delta 理论上 > 0（因为 p 已排序且若有相等说明重复访问秩，通常不会发生）
+            sumAbs += std::fabs(static_cast<double>(delta) - deltaStar);
+        }
+
+        return sumAbs / (static_cast<double>(K2 - 1) * deltaStar);
+    }
+
+    // 分支悬挂度：各 parent 的 children 访问秩跨度（max - min）的平均，只统计 >= 2 个 child 的 parent
+    static double branchSuspensionOnPos(const std::vector<int> &pos, const std::vector<Index> &parent)
     {
-        Index cur = st.top();
-        auto neigh = graph.getNeighbors(cur);
+        const int n = static_cast<int>(parent.size());
+        std::vector<std::vector<int>> childPos(static_cast<std::size_t>(n));
+        for (int v = 0; v < n; ++v)
+        {
+            Index p = parent[static_cast<std::size_t>(v)];
+            if (p >= 0 && p < n)
+            {
+                int pv = pos[static_cast<std::size_t>(v)];
+                if (pv >= 0)
+                    childPos[static_cast<std::size_t>(p)].push_back(pv);
+            }
+        }
 
-        bool pushed = false;
-        std::size_t &i = nextIdx[static_cast<std::size_t>(cur)];
-        while (i < neigh.size())
+        double sumSpan = 0.0;
+        int cnt = 0;
+        for (int u = 0; u < n; ++u)
         {
-            Index v = neigh[i++];
-            if (v < 0 || v >= n)
+            auto &vec = childPos[static_cast<std::size_t>(u)];
+            if (vec.size() < 2)
                 continue;
-            if (!visited[v])
+            auto mm = std::minmax_element(vec.begin(), vec.end());
+            sumSpan += static_cast<double>(*mm.second - *mm.first);
+            cnt += 1;
+        }
+        if (cnt == 0)
+            return 0.0;
+        return sumSpan / static_cast<double>(cnt);
+    }
+
+    // 全根测量用的邻接快照：每个根都要完整遍历一次，getNeighbors 的拷贝只做一次
+    using AdjSnapshot = std::vector<std::vector<Index>>;
+
+    static AdjSnapshot snapshotAdjacency(const Graph &g)
+    {
+        const int n = static_cast<int>(g.getNodeCount());
+        AdjSnapshot adj(n > 0 ? static_cast<std::size_t>(n) : 0);
+        for (int v = 0; v < n; ++v)
+            adj[v] = g.getNeighbors(v);
+        return adj;
+    }
+
+    // 单根遍历的线程私有工作区，在同一线程处理的各个根之间复用
+    struct PeakWorkspace
+    {
+        std::vector<uint8_t> visited;
+        std::vector<std::size_t> nextIdx;
+        std::vector<Index> buf; // DFS 的路径栈 / BFS 的数组队列
+    };
+
+    // 从快照生成与 TraversalAlgo::bfsTrace / dfsTrace 相同的 trace（ROOT 出发，发现即标记；
+    // DFS 为一次压入全部未访问邻居的栈式遍历）
+    static TraversalTrace traceOnAdj(const AdjSnapshot &adj, bool bfs)
+    {
+        TraversalTrace t;
+        const std::size_t n = adj.size();
+        if (n == 0)
+            return t;
+
+        t.parent.assign(n, -1);
+        t.order.reserve(n);
+        std::vector<uint8_t> visited(n, 0);
+        std::vector<Index> frontier; // BFS：数组队列；DFS：栈
+        frontier.reserve(n);
+        std::size_t head = 0;
+
+        frontier.push_back(ROOT);
+        visited[ROOT] = 1;
+        while (bfs ? head < frontier.size() : !frontier.empty())
+        {
+            Index cur;
+            if (bfs)
             {
+                cur = frontier[head++];
+            }
+            else
+            {
+                cur = frontier.back();
+                frontier.pop_back();
+            }
+            t.order.push_back(cur);
+
+            for (Index v : adj[cur])
+            {
+                if (v < 0 || static_cast<std::size_t>(v) >= n || visited[v])
+                    continue;
                 visited[v] = 1;
-                st.push(v);
-                maxSize = std::max(maxSize, st.size());
-                pushed = true;
-                break; // 只沿一个邻居继续深入
+                t.parent[v] = cur;
+                frontier.push_back(v);
             }
         }
+        return t;
+    }
 
-        if (!pushed)
+    // measureSpaceMetrics 用的缓存模型：容量为不超过工作集 / CACHE_SIM_METRIC_FRACTION 的最大 2 的幂
+    // （至少一组），工作集按 cacheReplayOnAdj 的排布计（不含页对齐的空隙）
+    static CacheConfig metricCacheConfig(const AdjSnapshot &adj)
+    {
+        const std::size_t n = adj.size();
+        std::size_t m = 0;
+        for (const auto &neigh : adj)
+            m += neigh.size();
+        const std::size_t workingSet = (n + 1) * sizeof(std::uint64_t) + m * sizeof(Index) + n + n * sizeof(Index);
+
+        CacheConfig config;
+        config.lineBytes = CACHE_SIM_METRIC_LINE_BYTES;
+        config.ways = CACHE_SIM_METRIC_WAYS;
+        config.sizeBytes = config.lineBytes * config.ways;
+        while (config.sizeBytes * 2 <= workingSet / CACHE_SIM_METRIC_FRACTION)
+            config.sizeBytes *= 2;
+        return config;
+    }
+
+    // 在缓存模型上回放 traceOnAdj 的访存：每个数组放在独立的、按页对齐的虚拟地址区间
+    static CacheStats cacheReplayOnAdj(const AdjSnapshot &adj, bool bfs, const CacheConfig &config)
+    {
+        CacheSim cache(config);
+        const std::size_t n = adj.size();
+        if (n == 0)
+            return cache.stats();
+
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u)
+            offsets[u + 1] = offsets[u] + adj[u].size();
+
+        const std::uint64_t page = 4096;
+        auto regionAfter = [page](std::uint64_t base, std::uint64_t bytes)
         {
-            st.pop(); // 回溯
+            return (base + bytes + page - 1) / page * page;
+        };
+        const std::uint64_t offsetsBase = 0;
+        const std::uint64_t targetsBase = regionAfter(offsetsBase, (n + 1) * sizeof(std::uint64_t));
+        const std::uint64_t visitedBase = regionAfter(targetsBase, offsets[n] * sizeof(Index));
+        const std::uint64_t frontierBase = regionAfter(visitedBase, n);
+
+        std::vector<uint8_t> visited(n, 0);
+        std::vector<Index> frontier;
+        frontier.reserve(n);
+        std::size_t head = 0;
+
+        frontier.push_back(ROOT);
+        cache.access(frontierBase, sizeof(Index));
+        visited[ROOT] = 1;
+        cache.access(visitedBase + ROOT, 1);
+        while (bfs ? head < frontier.size() : !frontier.empty())
+        {
+            Index cur;
+            if (bfs)
+            {
+                cache.access(frontierBase + head * sizeof(Index), sizeof(Index));
+                cur = frontier[head++];
+            }
+            else
+            {
+                cache.access(frontierBase + (frontier.size() - 1) * sizeof(Index), sizeof(Index));
+                cur = frontier.back();
+                frontier.pop_back();
+            }
+
+            cache.access(offsetsBase + static_cast<std::uint64_t>(cur) * sizeof(std::uint64_t),
+                         2 * sizeof(std::uint64_t));
+            const std::vector<Index> &neigh = adj[cur];
+            for (std::size_t i = 0; i < neigh.size(); ++i)
+            {
+                cache.access(targetsBase + (offsets[cur] + i) * sizeof(Index), sizeof(Index));
+                const Index v = neigh[i];
+                if (v < 0 || static_cast<std::size_t>(v) >= n)
+                    continue;
+                cache.access(visitedBase + static_cast<std::uint64_t>(v), 1);
+                if (visited[v])
+                    continue;
+                visited[v] = 1;
+                cache.access(frontierBase + frontier.size() * sizeof(Index), sizeof(Index));
+                frontier.push_back(v);
+            }
         }
+        return cache.stats();
     }
-    return maxSize;
-}
+
+    // 单次：给定 root，测 Path-DFS 路径栈峰值（等价于递归 DFS 的最大递归深度）。
+    // rec 在每次入栈 / 出栈后记录栈大小；NullRecorder 时记录代码被编译器消除
+    template <typename Recorder>
+    static std::size_t dfsPeakImpl(const AdjSnapshot &adj, Index root, PeakWorkspace &ws, Recorder &rec)
+    {
+        const std::size_t n = adj.size();
+        ws.visited.assign(n, 0);
+        ws.nextIdx.assign(n, 0);
+        ws.buf.clear();
+
+        std::size_t maxSize = 1;
+        ws.buf.push_back(root);
+        TRIAL_COUNT(Pushes, 1);
+        ws.visited[root] = 1; // 标准 DFS：发现即标记
+        rec.record(ws.buf.size());
+
+        while (!ws.buf.empty())
+        {
+            const Index cur = ws.buf.back();
+            const std::vector<Index> &neigh = adj[cur];
+
+            bool pushed = false;
+            std::size_t &i = ws.nextIdx[cur];
+            while (i < neigh.size())
+            {
+                const Index v = neigh[i++];
+                if (v < 0 || static_cast<std::size_t>(v) >= n)
+                    continue;
+                TRIAL_COUNT(VisitedChecks, 1);
+                if (!ws.visited[v])
+                {
+                    ws.visited[v] = 1;
+                    ws.buf.push_back(v);
+                    TRIAL_COUNT(Pushes, 1);
+                    rec.record(ws.buf.size());
+                    maxSize = std::max(maxSize, ws.buf.size());
+                    pushed = true;
+                    break; // 只沿一个邻居继续深入
+                }
+            }
+
+            if (!pushed)
+            {
+                ws.buf.pop_back(); // 回溯
+                TRIAL_COUNT(Pops, 1);
+                rec.record(ws.buf.size());
+            }
+        }
+        return maxSize;
+    }
+
+    // 单次：给定 root，测 BFS 最大队列；rec 在每次入队 / 出队后记录队列大小
+    template <typename Recorder>
+    static std::size_t bfsPeakImpl(const AdjSnapshot &adj, Index root, PeakWorkspace &ws, Recorder &rec)
+    {
+        const std::size_t n = adj.size();
+        ws.visited.assign(n, 0);
+        ws.buf.resize(n); // 每个节点至多入队一次，数组队列不会越界
+
+        std::size_t head = 0, tail = 0, maxSize = 1;
+        ws.buf[tail++] = root;
+        TRIAL_COUNT(Pushes, 1);
+        ws.visited[root] = 1;
+        rec.record(tail - head);
+
+        while (head < tail)
+        {
+            const Index cur = ws.buf[head++];
+            TRIAL_COUNT(Pops, 1);
+            rec.record(tail - head);
+            for (Index v : adj[cur])
+            {
+                if (v < 0 || static_cast<std::size_t>(v) >= n)
+                    continue;
+                TRIAL_COUNT(VisitedChecks, 1);
+                if (!ws.visited[v])
+                {
+                    ws.visited[v] = 1;
+                    ws.buf[tail++] = v;
+                    TRIAL_COUNT(Pushes, 1);
+                    rec.record(tail - head);
+                    maxSize = std::max(maxSize, tail - head);
+                }
+            }
+        }
+        return maxSize;
+    }
+
+    static std::size_t dfsPeakOnAdj(const AdjSnapshot &adj, Index root, PeakWorkspace &ws)
+    {
+        NullRecorder rec;
+        return dfsPeakImpl(adj, root, ws, rec);
+    }
+
+    static std::size_t bfsPeakOnAdj(const AdjSnapshot &adj, Index root, PeakWorkspace &ws)
+    {
+        NullRecorder rec;
+        return bfsPeakImpl(adj, root, ws, rec);
+    }
+
+    // 字节模式的容器类型：分配全部经过 CountingAllocator
+    using CountedDeque = std::deque<Index, CountingAllocator<Index>>;
+    template <typename T>
+    using CountedVector = std::vector<T, CountingAllocator<T>>;
+
+    // 字节模式单根遍历的结果：元素数峰值与各容器字节峰值
+    struct BytesPeak
+    {
+        std::size_t elements = 0;
+        ContainerBytes bytes;
+    };
+
+    // 字节模式 BFS：std::queue（底层 std::deque）+ visited，遍历与 measureBFSMaxQueueFromRoot 相同
+    static BytesPeak bfsBytesOnAdj(const AdjSnapshot &adj, Index root)
+    {
+        const std::size_t n = adj.size();
+        ByteCounter total, frontierBytes, visitedBytes;
+        frontierBytes.parent = &total;
+        visitedBytes.parent = &total;
+
+        BytesPeak res;
+        {
+            CountedVector<uint8_t> visited(n, 0, CountingAllocator<uint8_t>(&visitedBytes));
+            std::queue<Index, CountedDeque> qu{CountedDeque(CountingAllocator<Index>(&frontierBytes))};
+
+            qu.push(root);
+            visited[root] = 1;
+            res.elements = qu.size();
+
+            while (!qu.empty())
+            {
+                const Index cur = qu.front();
+                qu.pop();
+                for (Index v : adj[cur])
+                {
+                    if (v < 0 || static_cast<std::size_t>(v) >= n)
+                        continue;
+                    if (!visited[v])
+                    {
+                        visited[v] = 1;
+                        qu.push(v);
+                        res.elements = std::max(res.elements, qu.size());
+                    }
+                }
+            }
+        }
+        res.bytes.frontier = frontierBytes.peak;
+        res.bytes.visited = visitedBytes.peak;
+        res.bytes.total = total.peak;
+        return res;
+    }
+
+    // 字节模式 Path-DFS：std::stack（底层 std::deque）+ visited + nextIdx，遍历与 measureDFSMaxStackFromRoot 相同
+    static BytesPeak dfsBytesOnAdj(const AdjSnapshot &adj, Index root)
+    {
+        const std::size_t n = adj.size();
+        ByteCounter total, frontierBytes, visitedBytes, nextIdxBytes;
+        frontierBytes.parent = &total;
+        visitedBytes.parent = &total;
+        nextIdxBytes.parent = &total;
+
+        BytesPeak res;
+        {
+            CountedVector<uint8_t> visited(n, 0, CountingAllocator<uint8_t>(&visitedBytes));
+            CountedVector<std::size_t> nextIdx(n, 0, CountingAllocator<std::size_t>(&nextIdxBytes));
+            std::stack<Index, CountedDeque> st{CountedDeque(CountingAllocator<Index>(&frontierBytes))};
+
+            st.push(root);
+            visited[root] = 1;
+            res.elements = st.size();
+
+            while (!st.empty())
+            {
+                const Index cur = st.top();
+                const std::vector<Index> &neigh = adj[cur];
+
+                bool pushed = false;
+                std::size_t &i = nextIdx[static_cast<std::size_t>(cur)];
+                while (i < neigh.size())
+                {
+                    const Index v = neigh[i++];
+                    if (v < 0 || static_cast<std::size_t>(v) >= n)
+                        continue;
+                    if (!visited[v])
+                    {
+                        visited[v] = 1;
+                        st.push(v);
+                        res.elements = std::max(res.elements, st.size());
+                        pushed = true;
+                        break;
+                    }
+                }
+
+                if (!pushed)
+                    st.pop();
+            }
+        }
+        res.bytes.frontier = frontierBytes.peak;
+        res.bytes.visited = visitedBytes.peak;
+        res.bytes.nextIdx = nextIdxBytes.peak;
+        res.bytes.total = total.peak;
+        return res;
+    }
+
+    // 把 (value, r) 计入“最小值及达到它的根”
+    static void offerRoot(std::size_t &best, std::vector<Index> &roots, std::size_t value, Index r)
+    {
+        if (value < best)
+        {
+            best = value;
+            roots.assign(1, r);
+        }
+        else if (value == best)
+        {
+            roots.push_back(r);
+        }
+    }
+
+    // 全根字节模式：与 rootsPeak 相同的分块并行与确定性合并，同时维护元素数与字节两种排名
+    template <typename Kernel>
+    static RootOptResult allRootsBytes(const AdjSnapshot &adj, Kernel kernel)
+    {
+        RootOptResult res;
+        const std::size_t count = adj.size();
+        if (count == 0)
+            return res;
+
+        ThreadPool &pool = ThreadPool::instance();
+        const unsigned workers = (count < PARALLEL_ROOTS_MIN_NODES) ? 1u : pool.size();
+        const std::size_t grain = std::max<std::size_t>(1, count / (static_cast<std::size_t>(workers) * 8));
+
+        std::vector<RootOptResult> partial(workers);
+        for (RootOptResult &p : partial)
+        {
+            p.bestPeak = static_cast<std::size_t>(-1);
+            p.bestPeakBytes = static_cast<std::size_t>(-1);
+        }
+
+        pool.parallelFor(
+            count, grain,
+            [&](unsigned w, std::size_t begin, std::size_t end)
+            {
+                RootOptResult &local = partial[w];
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const Index r = static_cast<Index>(i);
+                    const BytesPeak peak = kernel(adj, r);
+                    offerRoot(local.bestPeak, local.bestRoots, peak.elements, r);
+                    offerRoot(local.bestPeakBytes, local.bestBytesRoots, peak.bytes.total, r);
+                }
+            },
+            workers);
+
+        res.bestPeak = static_cast<std::size_t>(-1);
+        res.bestPeakBytes = static_cast<std::size_t>(-1);
+        for (const RootOptResult &p : partial)
+        {
+            res.bestPeak = std::min(res.bestPeak, p.bestPeak);
+            res.bestPeakBytes = std::min(res.bestPeakBytes, p.bestPeakBytes);
+        }
+        for (const RootOptResult &p : partial)
+        {
+            if (p.bestPeak == res.bestPeak)
+                res.bestRoots.insert(res.bestRoots.end(), p.bestRoots.begin(), p.bestRoots.end());
+            if (p.bestPeakBytes == res.bestPeakBytes)
+                res.bestBytesRoots.insert(res.bestBytesRoots.end(), p.bestBytesRoots.begin(), p.bestBytesRoots.end());
+        }
+        std::sort(res.bestRoots.begin(), res.bestRoots.end());
+        std::sort(res.bestBytesRoots.begin(), res.bestBytesRoots.end());
+        return res;
+    }
+
+    // 对 roots 中的每个根执行 kernel，取最小峰值及达到它的全部根。
+    // 根数达到 PARALLEL_ROOTS_MIN_NODES 时按根分块并行，每个 worker 持有自己的工作区与局部结果，
+    // 最后合并；bestRoots 合并后升序排列，与串行逐根扫描的结果完全一致。
+    template <typename Kernel>
+    static RootOptResult rootsPeak(const AdjSnapshot &adj, const std::vector<Index> &roots, Kernel kernel)
+    {
+        RootOptResult res;
+        if (roots.empty())
+            return res;
+
+        ThreadPool &pool = ThreadPool::instance();
+        const std::size_t count = roots.size();
+        const unsigned workers = (count < PARALLEL_ROOTS_MIN_NODES) ? 1u : pool.size();
+        const std::size_t grain = std::max<std::size_t>(1, count / (static_cast<std::size_t>(workers) * 8));
+
+        std::vector<PeakWorkspace> ws(workers);
+        std::vector<RootOptResult> partial(workers);
+        for (RootOptResult &p : partial)
+            p.bestPeak = static_cast<std::size_t>(-1);
+
+        pool.parallelFor(
+            count, grain,
+            [&](unsigned w, std::size_t begin, std::size_t end)
+            {
+                RootOptResult &local = partial[w];
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const Index r = roots[i];
+                    const std::size_t peak = kernel(adj, r, ws[w]);
+                    if (peak < local.bestPeak)
+                    {
+                        local.bestPeak = peak;
+                        local.bestRoots.assign(1, r);
+                    }
+                    else if (peak == local.bestPeak)
+                    {
+                        local.bestRoots.push_back(r);
+                    }
+                }
+            },
+            workers);
+
+        res.bestPeak = static_cast<std::size_t>(-1);
+        for (const RootOptResult &p : partial)
+            res.bestPeak = std::min(res.bestPeak, p.bestPeak);
+        for (const RootOptResult &p : partial)
+        {
+            if (p.bestPeak == res.bestPeak)
+                res.bestRoots.insert(res.bestRoots.end(), p.bestRoots.begin(), p.bestRoots.end());
+        }
+        std::sort(res.bestRoots.begin(), res.bestRoots.end());
+        return res;
+    }
+
+    template <typename Kernel>
+    static RootOptResult allRootsPeak(const AdjSnapshot &adj, Kernel kernel)
+    {
+        std::vector<Index> roots(adj.size());
+        for (std::size_t r = 0; r < roots.size(); ++r)
+            roots[r] = static_cast<Index>(r);
+        return rootsPeak(adj, roots, kernel);
+    }
+
+    // 森林上的全根 Path-DFS 峰值：在树上路径栈恰为根到当前节点的路径，与邻居顺序无关，
+    // 故峰值 = 根在所在树中的离心率 + 1，由换根 DP 一次求出全部根
+    static RootOptResult forestDfsPeaks(const AdjSnapshot &adj, std::vector<std::size_t> *peaks)
+    {
+        RootOptResult res;
+        if (adj.empty())
+        {
+            if (peaks)
+                peaks->clear();
+            return res;
+        }
+
+        std::vector<std::size_t> ecc = TreeRerooting::eccentricities(adj);
+        res.bestPeak = static_cast<std::size_t>(-1);
+        for (std::size_t r = 0; r < ecc.size(); ++r)
+        {
+            const std::size_t peak = ecc[r] + 1;
+            ecc[r] = peak;
+            if (peak < res.bestPeak)
+            {
+                res.bestPeak = peak;
+                res.bestRoots.assign(1, static_cast<Index>(r));
+            }
+            else if (peak == res.bestPeak)
+            {
+                res.bestRoots.push_back(static_cast<Index>(r));
+            }
+        }
+        if (peaks)
+            *peaks = std::move(ecc);
+        return res;
+    }
+
+    // 带剪枝的全根 BFS 峰值：先用多源 BFS 得到每个根的层宽剖面及峰值上下界，
+    // 下界超过“所有根上界最小值”的根不可能最优，直接丢弃；其余根按下界升序精确测量，
+    // 上下界相等时无需遍历。结果与逐根精确测量完全一致。
+    static RootOptResult prunedBfsRootsPeak(const AdjSnapshot &adj)
+    {
+        const std::vector<LevelProfile> profiles =
+            MultiSourceBFS::allLevelProfiles(CsrGraph::fromAdjacency(adj));
+
+        std::vector<std::size_t> lb(adj.size()), ub(adj.size());
+        std::size_t minUb = static_cast<std::size_t>(-1);
+        for (const LevelProfile &p : profiles)
+        {
+            lb[p.root] = p.peakLowerBound();
+            ub[p.root] = p.peakUpperBound();
+            minUb = std::min(minUb, ub[p.root]);
+        }
+
+        std::vector<Index> candidates;
+        for (std::size_t r = 0; r < adj.size(); ++r)
+        {
+            if (lb[r] <= minUb)
+                candidates.push_back(static_cast<Index>(r));
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [&](Index a, Index b)
+                  { return lb[a] != lb[b] ? lb[a] < lb[b] : a < b; });
+
+        auto kernel = [&](const AdjSnapshot &g, Index r, PeakWorkspace &ws) -> std::size_t
+        {
+            return lb[r] == ub[r] ? lb[r] : bfsPeakOnAdj(g, r, ws);
+        };
+
+        // 候选较多时并行精确测量；否则按下界顺序串行，一旦下界超过当前最优即可停止
+        if (candidates.size() >= PARALLEL_ROOTS_MIN_NODES)
+            return rootsPeak(adj, candidates, kernel);
+
+        RootOptResult res;
+        res.bestPeak = static_cast<std::size_t>(-1);
+        PeakWorkspace ws;
+        for (Index r : candidates)
+        {
+            if (lb[r] > res.bestPeak)
+                break;
+            const std::size_t peak = kernel(adj, r, ws);
+            if (peak < res.bestPeak)
+            {
+                res.bestPeak = peak;
+                res.bestRoots.assign(1, r);
+            }
+            else if (peak == res.bestPeak)
+            {
+                res.bestRoots.push_back(r);
+            }
+        }
+        std::sort(res.bestRoots.begin(), res.bestRoots.end());
+        return res;
+    }
+
+    // 抽样估计全根峰值：按度数（log2 分桶）分层，每层内随机顺序无放回抽取根；
+    // 每轮样本量翻倍，一半按层大小比例分配，一半优先给当前最优峰值所在（或尚未抽到）的层，
+    // 时间预算用完或全部根都已评估时停止
+    template <typename Kernel>
+    static PeakEstimate estimatePeak(const AdjSnapshot &adj, Kernel kernel, const PeakEstimateOptions &opt)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto t0 = Clock::now();
+        auto elapsedMs = [&t0]
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        };
+
+        PeakEstimate res;
+        const std::size_t n = adj.size();
+        res.totalRoots = n;
+        res.confidence = 1.0 - opt.delta;
+        if (n == 0)
+        {
+            res.exact = true;
+            return res;
+        }
+
+        // 1) 分层
+        std::vector<std::vector<Index>> strata;
+        for (std::size_t v = 0; v < n; ++v)
+        {
+            std::size_t bucket = 0;
+            for (std::size_t d = adj[v].size() + 1; d > 1; d >>= 1)
+                ++bucket;
+            if (strata.size() <= bucket)
+                strata.resize(bucket + 1);
+            strata[bucket].push_back(static_cast<Index>(v));
+        }
+        strata.erase(std::remove_if(strata.begin(), strata.end(), [](const std::vector<Index> &s)
+                                    { return s.empty(); }),
+                     strata.end());
+        std::mt19937 rng(opt.seed);
+        for (auto &s : strata)
+            std::shuffle(s.begin(), s.end(), rng);
+
+        const std::size_t S = strata.size();
+        std::vector<std::size_t> taken(S, 0);
+        std::vector<std::size_t> stratumBest(S, static_cast<std::size_t>(-1));
+        res.bestPeak = static_cast<std::size_t>(-1);
+
+        ThreadPool &pool = ThreadPool::instance();
+        std::vector<PeakWorkspace> ws(pool.size());
+        std::size_t roundSize = std::max<std::size_t>(1, opt.initialSamples);
+        if (opt.maxSamples > 0)
+            roundSize = std::min(roundSize, opt.maxSamples);
+
+        while (true)
+        {
+            // 2) 本轮分配
+            const std::size_t remaining = n - res.sampled;
+            const std::size_t want = std::min(roundSize, remaining);
+            std::vector<std::size_t> quota(S, 0);
+            std::size_t assigned = 0;
+
+            const std::size_t proportional = want / 2;
+            for (std::size_t s = 0; s < S && assigned < want; ++s)
+            {
+                const std::size_t left = strata[s].size() - taken[s];
+                std::size_t q = (proportional * strata[s].size() + n - 1) / n;
+                if (taken[s] == 0)
+                    q = std::max<std::size_t>(q, 1); // 每层至少抽到一次
+                q = std::min({q, left, want - assigned});
+                quota[s] = q;
+                assigned += q;
+            }
+
+            std::vector<std::size_t> byBest(S);
+            for (std::size_t s = 0; s < S; ++s)
+                byBest[s] = s;
+            std::stable_sort(byBest.begin(), byBest.end(), [&](std::size_t a, std::size_t b)
+                             { return stratumBest[a] < stratumBest[b]; });
+            for (std::size_t s : byBest)
+            {
+                if (assigned >= want)
+                    break;
+                const std::size_t q = std::min(strata[s].size() - taken[s] - quota[s], want - assigned);
+                quota[s] += q;
+                assigned += q;
+            }
+
+            std::vector<Index> batch;
+            std::vector<std::size_t> batchStratum;
+            batch.reserve(assigned);
+            for (std::size_t s = 0; s < S; ++s)
+            {
+                for (std::size_t i = 0; i < quota[s]; ++i)
+                {
+                    batch.push_back(strata[s][taken[s] + i]);
+                    batchStratum.push_back(s);
+                }
+                taken[s] += quota[s];
+            }
+
+            // 3) 并行精确测量本轮抽到的根
+            std::vector<std::size_t> peaks(batch.size(), 0);
+            const unsigned workers = (batch.size() < PARALLEL_ROOTS_MIN_NODES) ? 1u : pool.size();
+            pool.parallelFor(
+                batch.size(), 1,
+                [&](unsigned w, std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        peaks[i] = kernel(adj, batch[i], ws[w]);
+                },
+                workers);
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                const std::size_t s = batchStratum[i];
+                stratumBest[s] = std::min(stratumBest[s], peaks[i]);
+                if (peaks[i] < res.bestPeak)
+                {
+                    res.bestPeak = peaks[i];
+                    res.bestRoots.assign(1, batch[i]);
+                }
+                else if (peaks[i] == res.bestPeak)
+                {
+                    res.bestRoots.push_back(batch[i]);
+                }
+            }
+            res.sampled += batch.size();
+            ++res.rounds;
+
+            if (res.sampled >= n || (opt.maxSamples > 0 && res.sampled >= opt.maxSamples))
+                break;
+            // 按已观测的单根耗时截断下一轮，使其尽量落在剩余预算内
+            const double spent = elapsedMs();
+            const double perRoot = spent / static_cast<double>(res.sampled);
+            const double fit = (opt.timeBudgetMs - spent) / std::max(perRoot, 1e-9);
+            if (fit < 1.0)
+                break;
+            roundSize = std::min(roundSize * 2, static_cast<std::size_t>(std::min(fit, 1e18)));
+            if (opt.maxSamples > 0)
+                roundSize = std::min(roundSize, opt.maxSamples - res.sampled);
+        }
+        std::sort(res.bestRoots.begin(), res.bestRoots.end());
+
+        // 4) 置信界：层 s 内无放回抽取 k_s 个根且都不在该层“前 q_s 比例”的概率不超过 (1 - q_s)^{k_s}，
+        // 取 q_s = ln(S / δ) / k_s 并对各层做并集界，则以至少 1 - δ 的概率，
+        // 峰值严格小于 bestPeak 的根占全部根的比例不超过 Σ (|S_s| / n) · q_s（抽尽的层贡献 0）
+        res.exact = res.sampled >= n;
+        double bound = 0.0;
+        if (!res.exact)
+        {
+            const double logTerm = std::log(static_cast<double>(S) / opt.delta);
+            for (std::size_t s = 0; s < S; ++s)
+            {
+                if (taken[s] >= strata[s].size())
+                    continue;
+                const double q = (taken[s] == 0) ? 1.0 : std::min(1.0, logTerm / static_cast<double>(taken[s]));
+                bound += q * static_cast<double>(strata[s].size()) / static_cast<double>(n);
+            }
+        }
+        res.betterFractionBound = std::min(1.0, bound);
+        res.elapsedMs = elapsedMs();
+        return res;
+    }
+
+} // anonymous namespace
+
+// Metrics.cpp
 
 std::size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string> &order)
 {
@@ -203,6 +985,7 @@ std::size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::s
     std::size_t maxSize = 0;
 
     st.push(ROOT);
+    TRIAL_COUNT(Pushes, 1);
     visited[ROOT] = 1;
     order.push_back(graph.getNode(ROOT).label);
     maxSize = std::max(maxSize, st.size());
@@ -219,10 +1002,12 @@ std::size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::s
             Index v = neigh[i++];
             if (v < 0 || v >= n)
                 continue;
+            TRIAL_COUNT(VisitedChecks, 1);
             if (!visited[v])
             {
                 visited[v] = 1;
                 st.push(v);
+                TRIAL_COUNT(Pushes, 1);
                 order.push_back(graph.getNode(v).label);
                 maxSize = std::max(maxSize, st.size());
                 pushed = true;
@@ -233,6 +1018,7 @@ std::size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::s
         if (!pushed)
         {
             st.pop();
+            TRIAL_COUNT(Pops, 1);
         }
     }
     return maxSize;
@@ -253,6 +1039,7 @@ size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string
     std::size_t maxSize = 0;
 
     st.push(root);
+    TRIAL_COUNT(Pushes, 1);
     visited[root] = 1;
     order.push_back(graph.getNode(root).label);
     maxSize = std::max(maxSize, st.size());
@@ -269,10 +1056,12 @@ size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string
             Index v = neigh[i++];
             if (v < 0 || v >= n)
                 continue;
+            TRIAL_COUNT(VisitedChecks, 1);
             if (!visited[v])
             {
                 visited[v] = 1;
                 st.push(v);
+                TRIAL_COUNT(Pushes, 1);
                 order.push_back(graph.getNode(v).label);
                 maxSize = std::max(maxSize, st.size());
                 pushed = true;
@@ -283,151 +1072,178 @@ size_t Metrics::measureDFSMaxStackFromRoot(Graph &graph, std::vector<std::string
         if (!pushed)
         {
             st.pop();
+            TRIAL_COUNT(Pops, 1);
         }
     }
     return maxSize;
 }
 
-// 单次：给定 root，测 BFS 最大队列
-std::size_t Metrics::bfsMaxQueueFromRoot(Graph &graph, Index root)
+RootOptResult Metrics::measureDFSMaxStack(Graph &graph)
 {
-    const int n = graph.getNodeCount();
-    if (n == 0)
-        return 0;
-
-    std::queue<Index> qu;
-    std::vector<uint8_t> visited(n, 0);
-
-    std::size_t maxSize = 0;
-
-    qu.push(root);
-    visited[root] = 1;
-    maxSize = std::max(maxSize, qu.size());
-
-    while (!qu.empty())
-    {
-        Index cur = qu.front();
-        qu.pop();
-
-        for (Index adj : graph.getNeighbors(cur))
-        {
-            if (adj < 0 || adj >= n)
-                continue;
-            if (!visited[adj])
-            {
-                visited[adj] = 1;
-                qu.push(adj);
-                maxSize = std::max(maxSize, qu.size());
-            }
-        }
-    }
-    return maxSize;
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureDFSMaxStack");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (TreeRerooting::isForest(adj))
+        return forestDfsPeaks(adj, nullptr);
+    return allRootsPeak(adj, dfsPeakOnAdj);
 }
 
-RootOptResult Metrics::measureDFSMaxStack(Graph &graph)
+SpaceMetrics Metrics::measureSpaceMetrics(Graph &graph)
 {
-    const int n = graph.getNodeCount();
-    RootOptResult res;
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureSpaceMetrics");
+    TRIAL_PHASE("measureSpaceMetrics");
+    SpaceMetrics res;
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    const int n = static_cast<int>(adj.size());
     if (n == 0)
         return res;
 
-    res.bestPeak = static_cast<std::size_t>(-1);
-    res.bestRoots.clear();
+    // 1) 全根峰值（共享同一份邻接快照）
+    {
+        TRIAL_TRACE_SPAN("Metrics", "allRootsPeak");
+        res.dfsMaxStack = TreeRerooting::isForest(adj) ? forestDfsPeaks(adj, nullptr) : allRootsPeak(adj, dfsPeakOnAdj);
+        res.bfsMaxQueue = (adj.size() < MULTI_SOURCE_MIN_NODES) ? allRootsPeak(adj, bfsPeakOnAdj) : prunedBfsRootsPeak(adj);
+    }
+
+    // 2) 每种遍历只跑一次 trace，HDS 与 BS 共用同一份访问秩；度数排序对两种遍历只算一次
+    std::vector<std::pair<int, int>> dv;
+    dv.reserve(adj.size());
+    for (int v = 0; v < n; ++v)
+        dv.push_back({static_cast<int>(adj[v].size()), v});
+    std::sort(dv.begin(), dv.end(), [](const auto &a, const auto &b)
+              {
+            if (a.first != b.first) return a.first > b.first; // degree desc
+            return a.second < b.second; });
+    const std::vector<int> top = topDegreeNodes(dv);
 
-    for (Index r = 0; r < n; ++r)
+    auto fill = [&](bool bfs, double &hds, double &bs)
     {
-        const std::size_t peak = dfsMaxStackFromRoot(graph, r);
+        const TraversalTrace t = traceOnAdj(adj, bfs);
+        const std::vector<int> pos = buildPos(t.order, adj.size());
+        hds = (t.order.size() < 2) ? 0.0 : highDegreeSpacingOnPos(pos, top);
+        bs = branchSuspensionOnPos(pos, t.parent);
+    };
+    {
+        TRIAL_TRACE_SPAN("Metrics", "traceMetrics");
+        fill(true, res.bfsHDS, res.bfsBS);
+        fill(false, res.dfsHDS, res.dfsBS);
+    }
 
-        if (peak < res.bestPeak)
-        {
-            res.bestPeak = peak;
-            res.bestRoots.assign(1, r);
-        }
-        else if (peak == res.bestPeak)
-        {
-            res.bestRoots.push_back(r);
-        }
+    // 3) 随工作集缩放的小缓存模型下的模拟缺失数
+    {
+        TRIAL_TRACE_SPAN("Metrics", "cacheReplay");
+        const CacheConfig config = metricCacheConfig(adj);
+        res.bfsCacheMiss = cacheReplayOnAdj(adj, true, config).misses;
+        res.dfsCacheMiss = cacheReplayOnAdj(adj, false, config).misses;
     }
     return res;
 }
 
-RootOptResult Metrics::measureBFSMaxQueue(Graph &graph)
+CacheStats Metrics::measureBFSCacheMisses(Graph &graph, const CacheConfig &config)
 {
-    const int n = graph.getNodeCount();
-    RootOptResult res;
-    if (n == 0)
-        return res;
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureBFSCacheMisses");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return cacheReplayOnAdj(adj, true, config);
+}
 
-    res.bestPeak = static_cast<std::size_t>(-1);
-    res.bestRoots.clear();
+CacheStats Metrics::measureDFSCacheMisses(Graph &graph, const CacheConfig &config)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureDFSCacheMisses");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return cacheReplayOnAdj(adj, false, config);
+}
 
-    for (Index r = 0; r < n; ++r)
-    {
-        const std::size_t peak = bfsMaxQueueFromRoot(graph, r);
+bool Metrics::measureForestDFSMaxStack(Graph &graph, RootOptResult &res, std::vector<std::size_t> &peaks)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureForestDFSMaxStack");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (!TreeRerooting::isForest(adj))
+        return false;
+    res = forestDfsPeaks(adj, &peaks);
+    return true;
+}
 
-        if (peak < res.bestPeak)
-        {
-            res.bestPeak = peak;
-            res.bestRoots.assign(1, r);
-        }
-        else if (peak == res.bestPeak)
-        {
-            res.bestRoots.push_back(r);
-        }
-    }
-    return res;
+RootOptResult Metrics::measureBFSMaxQueue(Graph &graph)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureBFSMaxQueue");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (adj.size() < MULTI_SOURCE_MIN_NODES)
+        return allRootsPeak(adj, bfsPeakOnAdj);
+    return prunedBfsRootsPeak(adj);
 }
 
-// 计算大度节点间距
-double Metrics::highDegreeSpacingImpl(const Graph &graph, const TraversalTrace &t)
+ContainerBytes Metrics::measureBFSBytesFromRoot(Graph &graph, Index root)
 {
-    const int n = static_cast<int>(graph.getNodeCount());
-    if (n <= 0 || t.order.size() < 2)
-        return 0.0;
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (root < 0 || static_cast<std::size_t>(root) >= adj.size())
+        return ContainerBytes();
+    return bfsBytesOnAdj(adj, root).bytes;
+}
 
-    // 访问秩
-    std::vector<int> pos = buildPos(t.order, static_cast<std::size_t>(n));
+ContainerBytes Metrics::measureDFSBytesFromRoot(Graph &graph, Index root)
+{
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (root < 0 || static_cast<std::size_t>(root) >= adj.size())
+        return ContainerBytes();
+    return dfsBytesOnAdj(adj, root).bytes;
+}
 
-    // Top-K：默认 K = ceil(sqrt(n))，至少2，至多n
-    int K = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n))));
-    K = std::max(2, K);
-    K = std::min(K, n);
+RootOptResult Metrics::measureBFSMaxQueueBytes(Graph &graph)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureBFSMaxQueueBytes");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return allRootsBytes(adj, bfsBytesOnAdj);
+}
 
-    // 取度数 Top-K 节点
-    auto dv = degreesWithId(graph); // (deg, id) 按 deg 降序
-    std::vector<int> p;
-    p.reserve(static_cast<std::size_t>(K));
-    for (int i = 0; i < K; ++i)
-    {
-        int v = dv[static_cast<std::size_t>(i)].second;
-        int pv = pos[static_cast<std::size_t>(v)];
-        if (pv >= 0)
-            p.push_back(pv); // 非连通时可能 -1，跳过
-    }
+RootOptResult Metrics::measureDFSMaxStackBytes(Graph &graph)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::measureDFSMaxStackBytes");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return allRootsBytes(adj, dfsBytesOnAdj);
+}
 
-    if (p.size() < 2)
-        return -1.0; // 无法计算间距
+std::size_t Metrics::recordBFSOccupancy(Graph &graph, Index root, OccupancyTimeline &timeline)
+{
+    timeline.clear();
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (root < 0 || static_cast<std::size_t>(root) >= adj.size())
+        return 0;
+    PeakWorkspace ws;
+    return bfsPeakImpl(adj, root, ws, timeline);
+}
 
-    std::sort(p.begin(), p.end());
+std::size_t Metrics::recordDFSOccupancy(Graph &graph, Index root, OccupancyTimeline &timeline)
+{
+    timeline.clear();
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    if (root < 0 || static_cast<std::size_t>(root) >= adj.size())
+        return 0;
+    PeakWorkspace ws;
+    return dfsPeakImpl(adj, root, ws, timeline);
+}
 
-    const int K2 = static_cast<int>(p.size());
-    if (K2 < 2)
-        return -1.0;
+PeakEstimate Metrics::estimateBFSMaxQueue(Graph &graph, const PeakEstimateOptions &options)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::estimateBFSMaxQueue");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return estimatePeak(adj, bfsPeakOnAdj, options);
+}
 
-    const double deltaStar = static_cast<double>(n - 1) / static_cast<double>(K2 - 1);
-    if (deltaStar <= 0.0)
-        return 1.0; // 退化情况，视为“最好”
+PeakEstimate Metrics::estimateDFSMaxStack(Graph &graph, const PeakEstimateOptions &options)
+{
+    TRIAL_TRACE_SPAN("Metrics", "Metrics::estimateDFSMaxStack");
+    const AdjSnapshot adj = snapshotAdjacency(graph);
+    return estimatePeak(adj, dfsPeakOnAdj, options);
+}
 
-    double sumAbs = 0.0;
-    for (int i = 0; i + 1 < K2; ++i)
-    {
-        const int delta = p[i + 1] - p[i];
-        // delta 理论上 > 0（因为 p 已排序且若有相等说明重复访问秩，通常不会发生）
-        sumAbs += std::fabs(static_cast<double>(delta) - deltaStar);
-    }
+// 计算大度节点间距
+double Metrics::highDegreeSpacingImpl(const Graph &graph, const TraversalTrace &t)
+{
+    const int n = static_cast<int>(graph.getNodeCount());
+    if (n <= 0 || t.order.size() < 2)
+        return 0.0;
 
-    const double hdsNorm = sumAbs / (static_cast<double>(K2 - 1) * deltaStar);
-    return hdsNorm;
+    std::vector<int> pos = buildPos(t.order, static_cast<std::size_t>(n));
+    return highDegreeSpacingOnPos(pos, topDegreeNodes(degreesWithId(graph)));
 }
 
 // 分支悬挂度：对每个 parent，收集其 children 的访问位置，
@@ -441,33 +1257,7 @@ double Metrics::branchSuspensionImpl(const TraversalTrace &t)
         return 0.0;
 
     auto pos = buildPos(t.order, static_cast<std::size_t>(n));
-
-    std::vector<std::vector<int>> childPos(static_cast<std::size_t>(n));
-    for (int v = 0; v < n; ++v)
-    {
-        Index p = t.parent[static_cast<std::size_t>(v)];
-        if (p >= 0 && p < n)
-        {
-            int pv = pos[static_cast<std::size_t>(v)];
-            if (pv >= 0)
-                childPos[static_cast<std::size_t>(p)].push_back(pv);
-        }
-    }
-
-    double sumSpan = 0.0;
-    int cnt = 0;
-    for (int u = 0; u < n; ++u)
-    {
-        auto &vec = childPos[static_cast<std::size_t>(u)];
-        if (vec.size() < 2)
-            continue;
-        auto mm = std::minmax_element(vec.begin(), vec.end());
-        sumSpan += static_cast<double>(*mm.second - *mm.first);
-        cnt += 1;
-    }
-    if (cnt == 0)
-        return 0.0;
-    return sumSpan / static_cast<double>(cnt);
+    return branchSuspensionOnPos(pos, t.parent);
 }
 
 // 计算 Pearson 相关系数
@@ -477,28 +1267,10 @@ double Metrics::pearsonCorr(const std::vector<double> &x,
     if (x.size() != y.size() || x.size() < 2)
         return 0.0;
 
-    const std::size_t n = x.size();
-    double mx = 0.0, my = 0.0;
-    for (std::size_t i = 0; i < n; ++i)
-    {
-        mx += x[i];
-        my += y[i];
-    }
-    mx /= static_cast<double>(n);
-    my /= static_cast<double>(n);
-
-    double num = 0.0, vx = 0.0, vy = 0.0;
-    for (std::size_t i = 0; i < n; ++i)
-    {
-        double dx = x[i] - mx;
-        double dy = y[i] - my;
-        num += dx * dy;
-        vx += dx * dx;
-        vy += dy * dy;
-    }
-    if (vx <= 0.0 || vy <= 0.0)
-        return 0.0;
-    return num / std::sqrt(vx * vy);
+    RunningCovariance cov;
+    for (std::size_t i = 0; i < x.size(); ++i)
+        cov.push(x[i], y[i]);
+    return cov.pearson();
 }
 
 bool Metrics::hasHighDegreeNode(Graph &graph)
@@ -538,6 +1310,7 @@ std::size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::s
     std::size_t maxSize = 0;
 
     qu.push(ROOT);
+    TRIAL_COUNT(Pushes, 1);
     visited[ROOT] = 1;
     maxSize = std::max(maxSize, qu.size());
 
@@ -545,6 +1318,7 @@ std::size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::s
     {
         Index cur = qu.front();
         qu.pop();
+        TRIAL_COUNT(Pops, 1);
 
         order.push_back(graph.getNode(cur).label);
 
@@ -552,10 +1326,12 @@ std::size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::s
         {
             if (adj < 0 || adj >= n)
                 continue;
+            TRIAL_COUNT(VisitedChecks, 1);
             if (!visited[adj])
             {
                 visited[adj] = 1;
                 qu.push(adj);
+                TRIAL_COUNT(Pushes, 1);
                 maxSize = std::max(maxSize, qu.size());
             }
         }
@@ -576,6 +1352,7 @@ size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string
     std::size_t maxSize = 0;
 
     qu.push(root);
+    TRIAL_COUNT(Pushes, 1);
     visited[root] = 1;
     maxSize = std::max(maxSize, qu.size());
 
@@ -583,6 +1360,7 @@ size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string
     {
         Index cur = qu.front();
         qu.pop();
+        TRIAL_COUNT(Pops, 1);
 
         order.push_back(graph.getNode(cur).label);
 
@@ -590,10 +1368,12 @@ size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string
         {
             if (adj < 0 || adj >= n)
                 continue;
+            TRIAL_COUNT(VisitedChecks, 1);
             if (!visited[adj])
             {
                 visited[adj] = 1;
                 qu.push(adj);
+                TRIAL_COUNT(Pushes, 1);
                 maxSize = std::max(maxSize, qu.size());
             }
         }
@@ -601,44 +1381,152 @@ size_t Metrics::measureBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string
     return maxSize;
 }
 
+size_t Metrics::measureIDDFSMaxStackFromRoot(Graph &graph, std::vector<std::string> &order, Index root,
+                                             std::size_t &expansions)
+{
+    order.clear();
+    TraversalCost cost;
+    TraversalTrace t = TraversalAlgo::iddfsTrace(graph, root, &cost);
+    order.reserve(t.order.size());
+    for (Index v : t.order)
+    {
+        order.push_back(graph.getNode(v).label);
+    }
+    expansions = cost.expansions;
+    return cost.peak + cost.auxiliary;
+}
+
+size_t Metrics::measureCappedBFSMaxQueueFromRoot(Graph &graph, std::vector<std::string> &order, Index root,
+                                                 std::size_t budget, std::size_t &expansions)
+{
+    order.clear();
+    TraversalCost cost;
+    TraversalTrace t = TraversalAlgo::cappedBfsTrace(graph, budget, root, &cost);
+    order.reserve(t.order.size());
+    for (Index v : t.order)
+    {
+        order.push_back(graph.getNode(v).label);
+    }
+    expansions = cost.expansions;
+    return cost.peak;
+}
+
+// 字符串版本：先把标签映射为整数 id（两个序列共享同一映射），再走位并行 LCS
 double Metrics::getLcsSimilarity(const std::vector<std::string> &orderA,
                                  const std::vector<std::string> &orderB)
 {
-    const std::size_t sizeA = orderA.size();
-    const std::size_t sizeB = orderB.size();
-    const std::size_t maxSize = std::max(sizeA, sizeB);
+    std::unordered_map<std::string, int> ids;
+    ids.reserve(orderA.size() + orderB.size());
+    auto intern = [&ids](const std::vector<std::string> &order)
+    {
+        std::vector<int> coded;
+        coded.reserve(order.size());
+        for (const auto &label : order)
+            coded.push_back(ids.emplace(label, static_cast<int>(ids.size())).first->second);
+        return coded;
+    };
+    const std::vector<int> codedA = intern(orderA);
+    const std::vector<int> codedB = intern(orderB);
+    return getLcsSimilarity(codedA, codedB);
+}
 
+double Metrics::getLcsSimilarity(const std::vector<int> &orderA, const std::vector<int> &orderB)
+{
+    const std::size_t maxSize = std::max(orderA.size(), orderB.size());
     if (maxSize == 0)
     {
         return 1.0;
     }
-    if (sizeA == 0 || sizeB == 0)
+    if (orderA.empty() || orderB.empty())
     {
         return 0.0;
     }
+    return static_cast<double>(lcsLength(orderA, orderB)) / static_cast<double>(maxSize);
+}
 
-    std::vector<int> prev(sizeB + 1, 0);
-    std::vector<int> cur(sizeB + 1, 0);
-
-    for (std::size_t i = 1; i <= sizeA; ++i)
+namespace
+{
+    // Hyyrö 的位并行 LCS：A 的每个位置占一位，V 中的 0 位个数即为当前 LCS 长度。
+    // 对 B 的每个元素 b：U = V & Match[b]，V = (V + U) | (V - U)。
+    // 由于 U ⊆ V，V - U 无借位（等于 V & ~U），多字实现只需在加法中传播进位。O(|A|·|B| / 64)
+    // rowOf(b) 返回 b 在 A 中的匹配位图行（每行 (m + 63) / 64 个字），不在 A 中返回 nullptr
+    template <typename RowOf>
+    std::size_t lcsBitParallel(std::size_t m, const std::vector<int> &orderB, RowOf rowOf)
     {
-        for (std::size_t j = 1; j <= sizeB; ++j)
+        const std::size_t words = (m + 63) / 64;
+        // 短序列的 V 放在栈上，批量逐对计算时不再分配
+        uint64_t local[8];
+        std::vector<uint64_t> heap;
+        uint64_t *V = local;
+        if (words > 8)
         {
-            if (orderA[i - 1] == orderB[j - 1])
-            {
-                cur[j] = prev[j - 1] + 1;
-            }
-            else
+            heap.resize(words);
+            V = heap.data();
+        }
+        std::fill(V, V + words, ~uint64_t(0));
+
+        for (int b : orderB)
+        {
+            const uint64_t *row = rowOf(b);
+            if (row == nullptr)
+                continue; // 不在 A 中：U = 0，V 不变
+
+            uint64_t carry = 0;
+            for (std::size_t w = 0; w < words; ++w)
             {
-                cur[j] = std::max(prev[j], cur[j - 1]);
+                const uint64_t v = V[w];
+                const uint64_t u = v & row[w];
+                const uint64_t sum = v + u + carry;
+                carry = (sum < v || (carry && sum == v)) ? 1 : 0;
+                V[w] = sum | (v & ~u);
             }
         }
-        std::swap(prev, cur);
-        std::fill(cur.begin(), cur.end(), 0);
+
+        std::size_t ones = 0;
+        for (std::size_t w = 0; w < words; ++w)
+        {
+            uint64_t v = V[w];
+            if (w + 1 == words && (m & 63) != 0)
+                v &= (uint64_t(1) << (m & 63)) - 1; // 只统计前 m 位
+            ones += popcount64(v);
+        }
+        return m - ones;
     }
+}
 
-    const double lcs = static_cast<double>(prev[sizeB]);
-    return lcs / static_cast<double>(maxSize);
+std::size_t Metrics::lcsLength(const std::vector<int> &orderA, const std::vector<int> &orderB)
+{
+    const std::size_t m = orderA.size();
+    if (m == 0 || orderB.empty())
+        return 0;
+    const std::size_t words = (m + 63) / 64;
+
+    // A 中出现的元素压缩为 0..k-1，每个元素一行匹配位图
+    std::unordered_map<int, std::size_t> symbol;
+    symbol.reserve(m);
+    for (int x : orderA)
+        symbol.emplace(x, symbol.size());
+    std::vector<uint64_t> match(symbol.size() * words, 0);
+    for (std::size_t i = 0; i < m; ++i)
+        match[symbol[orderA[i]] * words + (i >> 6)] |= uint64_t(1) << (i & 63);
+
+    return lcsBitParallel(m, orderB, [&](int b) -> const uint64_t *
+                          {
+        auto it = symbol.find(b);
+        return it == symbol.end() ? nullptr : match.data() + it->second * words; });
+}
+
+std::size_t Metrics::lcsLength(const uint64_t *match, std::size_t m, const std::vector<int> &rowOf,
+                               const std::vector<int> &orderB)
+{
+    if (m == 0 || orderB.empty())
+        return 0;
+    const std::size_t words = (m + 63) / 64;
+    return lcsBitParallel(m, orderB, [&](int b) -> const uint64_t *
+                          {
+        if (b < 0 || static_cast<std::size_t>(b) >= rowOf.size() || rowOf[b] < 0)
+            return nullptr;
+        return match + static_cast<std::size_t>(rowOf[b]) * words; });
 }
 
 double Metrics::getKendallSimilarity(const std::vector<std::string> &orderA,
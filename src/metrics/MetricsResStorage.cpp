@@ -21,6 +21,14 @@ const std::vector<double>& MetricsResStorage::getDfsBS() const {
     return this->dfsBS;
 }
 
+const std::vector<size_t>& MetricsResStorage::getBfsCacheMiss() const {
+    return this->bfsCacheMiss;
+}
+
+const std::vector<size_t>& MetricsResStorage::getDfsCacheMiss() const {
+    return this->dfsCacheMiss;
+}
+
 size_t MetricsResStorage::getResGroupSize() const {
     return resGroupSize;
 }
@@ -32,6 +40,8 @@ bool MetricsResStorage::append(
     double _dfsHDS,
     double _bfsBS,
     double _dfsBS,
+    size_t _bfsCacheMiss,
+    size_t _dfsCacheMiss,
     std::string _label) {
     resGroupSize = this->bfsBS.size();
     if(
@@ -40,6 +50,8 @@ bool MetricsResStorage::append(
         resGroupSize != this->dfsHDS.size() ||
         resGroupSize != this->bfsMaxQueue.size() ||
         resGroupSize != this->dfsMaxStack.size() ||
+        resGroupSize != this->bfsCacheMiss.size() ||
+        resGroupSize != this->dfsCacheMiss.size() ||
         resGroupSize != this->label.size()
         ) {
             return false;
@@ -51,6 +63,8 @@ bool MetricsResStorage::append(
     this->bfsHDS.push_back(_bfsHDS);
     this->dfsMaxStack.push_back(_dfsMaxStack);
     this->bfsMaxQueue.push_back(_bfsMaxQueue);
+    this->bfsCacheMiss.push_back(_bfsCacheMiss);
+    this->dfsCacheMiss.push_back(_dfsCacheMiss);
     this->label.push_back(_label);
 
     resGroupSize += 1;
@@ -68,6 +82,8 @@ void MetricsResStorage::merge(MetricsResStorage& another) {
         another.dfsHDS.size()     != another.resGroupSize ||
         another.bfsBS.size()      != another.resGroupSize ||
         another.dfsBS.size()      != another.resGroupSize ||
+        another.bfsCacheMiss.size() != another.resGroupSize ||
+        another.dfsCacheMiss.size() != another.resGroupSize ||
         another.label.size() != another.resGroupSize) {
             return;
     }
@@ -80,6 +96,8 @@ void MetricsResStorage::merge(MetricsResStorage& another) {
     dfsHDS.reserve(resGroupSize + add);
     bfsBS.reserve(resGroupSize + add);
     dfsBS.reserve(resGroupSize + add);
+    bfsCacheMiss.reserve(resGroupSize + add);
+    dfsCacheMiss.reserve(resGroupSize + add);
     label.reserve(resGroupSize + add);
 
     dfsMaxStack.insert(dfsMaxStack.end(), another.dfsMaxStack.begin(), another.dfsMaxStack.end());
@@ -88,6 +106,8 @@ void MetricsResStorage::merge(MetricsResStorage& another) {
     dfsHDS.insert(dfsHDS.end(), another.dfsHDS.begin(), another.dfsHDS.end());
     bfsBS.insert(bfsBS.end(), another.bfsBS.begin(), another.bfsBS.end());
     dfsBS.insert(dfsBS.end(), another.dfsBS.begin(), another.dfsBS.end());
+    bfsCacheMiss.insert(bfsCacheMiss.end(), another.bfsCacheMiss.begin(), another.bfsCacheMiss.end());
+    dfsCacheMiss.insert(dfsCacheMiss.end(), another.dfsCacheMiss.begin(), another.dfsCacheMiss.end());
     label.insert(label.end(), another.label.begin(), another.label.end());
 
     resGroupSize += add;
@@ -102,6 +122,8 @@ void MetricsResStorage::clear() {
     dfsHDS.clear();
     bfsBS.clear();
     dfsBS.clear();
+    bfsCacheMiss.clear();
+    dfsCacheMiss.clear();
     label.clear();
 }
 
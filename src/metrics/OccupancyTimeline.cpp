@@ -0,0 +1,95 @@
+#include "OccupancyTimeline.hpp"
+#include <algorithm>
+
+void OccupancyTimeline::record(std::size_t size)
+{
+    const std::int64_t delta = static_cast<std::int64_t>(size) - static_cast<std::int64_t>(current);
+    if (!runs.empty() && runs.back().delta == delta)
+        ++runs.back().count;
+    else
+        runs.push_back(Run{delta, 1});
+    current = size;
+    ++stepCount;
+    maxSize = std::max(maxSize, size);
+}
+
+void OccupancyTimeline::clear()
+{
+    runs.clear();
+    current = 0;
+    stepCount = 0;
+    maxSize = 0;
+}
+
+std::vector<std::size_t> OccupancyTimeline::expand() const
+{
+    std::vector<std::size_t> out;
+    out.reserve(stepCount);
+    std::int64_t s = 0;
+    for (const Run &r : runs)
+    {
+        for (std::size_t k = 0; k < r.count; ++k)
+        {
+            s += r.delta;
+            out.push_back(static_cast<std::size_t>(s));
+        }
+    }
+    return out;
+}
+
+// 一个游程内的占用是等差数列 s + d, s + 2d, ..., s + c·d，按公式逐游程求和
+double OccupancyTimeline::areaUnderCurve() const
+{
+    double area = 0.0;
+    double s = 0.0;
+    for (const Run &r : runs)
+    {
+        const double c = static_cast<double>(r.count);
+        const double d = static_cast<double>(r.delta);
+        area += c * s + d * c * (c + 1.0) / 2.0;
+        s += c * d;
+    }
+    return area;
+}
+
+double OccupancyTimeline::meanOccupancy() const
+{
+    return stepCount == 0 ? 0.0 : areaUnderCurve() / static_cast<double>(stepCount);
+}
+
+std::size_t OccupancyTimeline::stepsAbove(std::size_t threshold) const
+{
+    const std::int64_t t = static_cast<std::int64_t>(threshold);
+    std::size_t above = 0;
+    std::int64_t s = 0;
+    for (const Run &r : runs)
+    {
+        const std::int64_t c = static_cast<std::int64_t>(r.count);
+        const std::int64_t d = r.delta;
+        // 统计 k ∈ [1, c] 中 s + k·d > t 的个数
+        if (d == 0)
+        {
+            if (s > t)
+                above += r.count;
+        }
+        else if (d > 0)
+        {
+            // k > (t - s) / d
+            const std::int64_t kMin = (t - s) >= 0 ? (t - s) / d + 1 : 1;
+            if (kMin <= c)
+                above += static_cast<std::size_t>(c - std::max<std::int64_t>(kMin, 1) + 1);
+        }
+        else
+        {
+            // s + k·d > t  <=>  k < (s - t) / |d|
+            const std::int64_t diff = s - t;
+            if (diff > 0)
+            {
+                const std::int64_t kMax = (diff - 1) / (-d);
+                above += static_cast<std::size_t>(std::min(kMax, c));
+            }
+        }
+        s += c * d;
+    }
+    return above;
+}
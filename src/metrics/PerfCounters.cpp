@@ -0,0 +1,190 @@
+#include "PerfCounters.hpp"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+bool PerfCounts::valid() const
+{
+    for (int e = 0; e < EventCount; ++e)
+    {
+        if (value[e] >= 0.0)
+            return true;
+    }
+    return false;
+}
+
+double PerfCounts::ipc() const
+{
+    if (!has(Cycles) || !has(Instructions) || value[Cycles] <= 0.0)
+        return -1.0;
+    return value[Instructions] / value[Cycles];
+}
+
+void PerfCounts::accumulate(const PerfCounts &other)
+{
+    for (int e = 0; e < EventCount; ++e)
+    {
+        if (other.value[e] < 0.0)
+            continue;
+        value[e] = (value[e] < 0.0) ? other.value[e] : value[e] + other.value[e];
+    }
+}
+
+PerfCounts PerfCounts::per(double divisor) const
+{
+    PerfCounts res = *this;
+    if (divisor <= 0.0)
+        return res;
+    for (int e = 0; e < EventCount; ++e)
+    {
+        if (res.value[e] >= 0.0)
+            res.value[e] /= divisor;
+    }
+    return res;
+}
+
+const char *PerfCounts::name(Event e)
+{
+    switch (e)
+    {
+    case Cycles:
+        return "cycles";
+    case Instructions:
+        return "instructions";
+    case BranchMisses:
+        return "branchMisses";
+    case L1dMisses:
+        return "l1dMisses";
+    case LlcMisses:
+        return "llcMisses";
+    default:
+        return "unknown";
+    }
+}
+
+#if defined(__linux__)
+
+namespace
+{
+    struct EventSpec
+    {
+        PerfCounts::Event event;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    constexpr std::uint64_t cacheConfig(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+    {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    const EventSpec EVENT_SPECS[] = {
+        {PerfCounts::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PerfCounts::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PerfCounts::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PerfCounts::L1dMisses, PERF_TYPE_HW_CACHE,
+         cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PerfCounts::LlcMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+
+    int openEvent(const EventSpec &spec, int groupFd)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = spec.type;
+        attr.config = spec.config;
+        attr.disabled = (groupFd < 0) ? 1 : 0; // 只有组长初始关闭，由它统一启停
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+}
+
+PerfCounters::PerfCounters()
+{
+    std::string firstError;
+    for (const EventSpec &spec : EVENT_SPECS)
+    {
+        const int fd = openEvent(spec, leader);
+        if (fd < 0)
+        {
+            if (firstError.empty())
+                firstError = std::string(PerfCounts::name(spec.event)) + ": " + std::strerror(errno);
+            continue;
+        }
+        if (leader < 0)
+            leader = fd;
+        fds.push_back(fd);
+        events.push_back(spec.event);
+    }
+
+    if (leader < 0)
+    {
+        statusText = "perf_event_open unavailable (" + firstError + ")";
+        return;
+    }
+    for (PerfCounts::Event e : events)
+    {
+        if (!statusText.empty())
+            statusText += ",";
+        statusText += PerfCounts::name(e);
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int fd : fds)
+        ::close(fd);
+}
+
+void PerfCounters::start()
+{
+    if (leader < 0)
+        return;
+    ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounts PerfCounters::stop()
+{
+    PerfCounts res;
+    if (leader < 0)
+        return res;
+    ::ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP 布局：nr | time_enabled | time_running | value[nr]
+    std::vector<std::uint64_t> buf(3 + fds.size());
+    const ssize_t want = static_cast<ssize_t>(buf.size() * sizeof(std::uint64_t));
+    if (::read(leader, buf.data(), static_cast<std::size_t>(want)) != want || buf[0] != fds.size() || buf[2] == 0)
+        return res;
+
+    const double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+    for (std::size_t i = 0; i < events.size(); ++i)
+        res.value[events[i]] = static_cast<double>(buf[3 + i]) * scale;
+    return res;
+}
+
+#else
+
+PerfCounters::PerfCounters() : statusText("perf_event_open is only available on Linux") {}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+PerfCounts PerfCounters::stop()
+{
+    return PerfCounts();
+}
+
+#endif
@@ -0,0 +1,215 @@
+#include "SimilarityMatrix.hpp"
+#include "Metrics.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+    const char SIMMAT_MAGIC[8] = {'S', 'I', 'M', 'M', 'A', 'T', '0', '2'};
+    const uint64_t LAYOUT_FULL = 0;
+    const uint64_t LAYOUT_UPPER = 1;
+}
+
+SimilarityMatrix::SimilarityMatrix(const vector<vector<string>> &ranks)
+{
+    unordered_map<string, int> ids;
+    coded.resize(ranks.size());
+    for (size_t r = 0; r < ranks.size(); ++r)
+    {
+        coded[r].reserve(ranks[r].size());
+        for (const auto &label : ranks[r])
+            coded[r].push_back(ids.emplace(label, static_cast<int>(ids.size())).first->second);
+    }
+    labelCount = ids.size();
+
+    // 与 getKendallSimilarity 一致：重复标签取最后一次出现的位置
+    pos.assign(ranks.size(), vector<int>());
+    for (size_t r = 0; r < coded.size(); ++r)
+    {
+        pos[r].assign(labelCount, -1);
+        for (size_t i = 0; i < coded[r].size(); ++i)
+        {
+            if (pos[r][coded[r][i]] >= 0)
+                hasDuplicates = true;
+            pos[r][coded[r][i]] = static_cast<int>(i);
+        }
+    }
+}
+
+double SimilarityMatrix::kendall(size_t a, size_t b) const
+{
+    const vector<int> &orderA = coded[a];
+    const vector<int> &posB = pos[b];
+    if (orderA.size() != coded[b].size())
+        return 0.0;
+
+    const size_t n = orderA.size();
+    if (n < 2)
+        return 1.0;
+
+    vector<size_t> bit(n + 1, 0);
+    size_t inversions = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int p = posB[orderA[i]];
+        if (p < 0)
+            return 0.0;
+        const size_t value = static_cast<size_t>(p);
+
+        size_t notGreater = 0;
+        for (size_t idx = value + 1; idx > 0; idx -= idx & (~idx + 1))
+            notGreater += bit[idx];
+        inversions += i - notGreater;
+        for (size_t idx = value + 1; idx < bit.size(); idx += idx & (~idx + 1))
+            bit[idx] += 1;
+    }
+
+    const double totalPairs = static_cast<double>(n) * (n - 1) / 2.0;
+    return 1.0 - 2.0 * static_cast<double>(inversions) / totalPairs;
+}
+
+void SimilarityMatrix::prepareRow(size_t a, Kind kind, vector<uint64_t> &matchA) const
+{
+    if (kind != Kind::LCS)
+        return;
+    // LCS 的匹配位图：每种标签一行，行号取 pos（最后一次出现的位置，秩内唯一）
+    const size_t m = coded[a].size();
+    const size_t words = (m + 63) / 64;
+    matchA.assign(m * words, 0);
+    for (size_t i = 0; i < m; ++i)
+    {
+        const size_t row = static_cast<size_t>(pos[a][coded[a][i]]);
+        matchA[row * words + (i >> 6)] |= uint64_t(1) << (i & 63);
+    }
+}
+
+double SimilarityMatrix::rowSimilarity(size_t a, size_t b, Kind kind, const vector<uint64_t> &matchA) const
+{
+    if (kind == Kind::Kendall)
+        return kendall(a, b);
+
+    // 与 Metrics::getLcsSimilarity 一致
+    const size_t maxSize = max(coded[a].size(), coded[b].size());
+    if (maxSize == 0)
+        return 1.0;
+    if (coded[a].empty() || coded[b].empty())
+        return 0.0;
+    const size_t length = Metrics::lcsLength(matchA.data(), coded[a].size(), pos[a], coded[b]);
+    return static_cast<double>(length) / static_cast<double>(maxSize);
+}
+
+double SimilarityMatrix::similarity(size_t i, size_t j, Kind kind) const
+{
+    vector<uint64_t> matchI;
+    prepareRow(i, kind, matchI);
+    return rowSimilarity(i, j, kind, matchI);
+}
+
+vector<double> SimilarityMatrix::full(Kind kind) const
+{
+    const size_t n = size();
+    vector<double> m(n * n, 0.0);
+    // 含重复标签时 Kendall 不再对称，此时逐对计算
+    const bool symmetric = kind == Kind::LCS || !hasDuplicates;
+    ThreadPool::instance().parallelFor(n, 1, [&](unsigned, size_t begin, size_t end)
+                                       {
+        vector<uint64_t> matchI;
+        for (size_t i = begin; i < end; ++i)
+        {
+            prepareRow(i, kind, matchI);
+            for (size_t j = symmetric ? i : 0; j < n; ++j)
+            {
+                const double s = rowSimilarity(i, j, kind, matchI);
+                m[i * n + j] = s;
+                if (symmetric)
+                    m[j * n + i] = s;
+            }
+        } });
+    return m;
+}
+
+vector<vector<pair<size_t, double>>> SimilarityMatrix::topK(Kind kind, size_t k) const
+{
+    const size_t n = size();
+    vector<vector<pair<size_t, double>>> res(n);
+    const size_t keep = min(k, n > 0 ? n - 1 : 0);
+
+    ThreadPool::instance().parallelFor(n, 1, [&](unsigned, size_t begin, size_t end)
+                                       {
+        vector<pair<size_t, double>> row;
+        vector<uint64_t> matchI;
+        for (size_t i = begin; i < end; ++i)
+        {
+            row.clear();
+            prepareRow(i, kind, matchI);
+            for (size_t j = 0; j < n; ++j)
+            {
+                if (j != i)
+                    row.emplace_back(j, rowSimilarity(i, j, kind, matchI));
+            }
+            auto better = [](const pair<size_t, double> &a, const pair<size_t, double> &b)
+            {
+                if (a.second != b.second)
+                    return a.second > b.second;
+                return a.first < b.first;
+            };
+            partial_sort(row.begin(), row.begin() + keep, row.end(), better);
+            res[i].assign(row.begin(), row.begin() + keep);
+        } });
+    return res;
+}
+
+void SimilarityMatrix::writeBinary(const string &path, Kind kind, size_t blockRows) const
+{
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        throw runtime_error("Failed to open similarity matrix file: " + path);
+    }
+
+    const size_t n = size();
+    blockRows = max<size_t>(1, blockRows);
+    // 含重复标签的 Kendall 不对称，写完整矩阵；其余只写上三角
+    const bool symmetric = kind == Kind::LCS || !hasDuplicates;
+    const uint64_t header[3] = {static_cast<uint64_t>(n), kind == Kind::Kendall ? 0u : 1u,
+                                symmetric ? LAYOUT_UPPER : LAYOUT_FULL};
+    bool ok = fwrite(SIMMAT_MAGIC, 1, sizeof(SIMMAT_MAGIC), fp) == sizeof(SIMMAT_MAGIC) &&
+              fwrite(header, sizeof(uint64_t), 3, fp) == 3;
+
+    // 逐块计算行 [first, first + rows)，算完按顺序追加写出；上三角时第 i 行只含 j >= i，每对只算一次
+    vector<double> block;
+    vector<size_t> rowStart;
+    for (size_t first = 0; ok && first < n; first += blockRows)
+    {
+        const size_t rows = min(blockRows, n - first);
+        rowStart.assign(rows + 1, 0);
+        for (size_t r = 0; r < rows; ++r)
+            rowStart[r + 1] = rowStart[r] + (symmetric ? n - (first + r) : n);
+        block.assign(rowStart[rows], 0.0);
+
+        ThreadPool::instance().parallelFor(rows, 1, [&](unsigned, size_t begin, size_t end)
+                                           {
+            vector<uint64_t> matchI;
+            for (size_t r = begin; r < end; ++r)
+            {
+                const size_t i = first + r;
+                prepareRow(i, kind, matchI);
+                double *out = block.data() + rowStart[r];
+                for (size_t j = symmetric ? i : 0; j < n; ++j)
+                    *out++ = rowSimilarity(i, j, kind, matchI);
+            } });
+        ok = fwrite(block.data(), sizeof(double), block.size(), fp) == block.size();
+    }
+
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        throw runtime_error("Failed to write similarity matrix file: " + path);
+    }
+}
@@ -0,0 +1,90 @@
+#include "StreamingStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+void RunningStats::push(double x)
+{
+    ++n;
+    const double delta = x - mu;
+    mu += delta / static_cast<double>(n);
+    m2 += delta * (x - mu);
+    lo = std::min(lo, x);
+    hi = std::max(hi, x);
+}
+
+// Chan 等人的并行合并公式
+void RunningStats::merge(const RunningStats &other)
+{
+    if (other.n == 0)
+        return;
+    if (n == 0)
+    {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(n), nb = static_cast<double>(other.n);
+    const double total = na + nb;
+    const double delta = other.mu - mu;
+    mu += delta * nb / total;
+    m2 += other.m2 + delta * delta * na * nb / total;
+    n += other.n;
+    lo = std::min(lo, other.lo);
+    hi = std::max(hi, other.hi);
+}
+
+double RunningStats::variance() const
+{
+    return n == 0 ? 0.0 : m2 / static_cast<double>(n);
+}
+
+double RunningStats::sampleVariance() const
+{
+    return n < 2 ? 0.0 : m2 / static_cast<double>(n - 1);
+}
+
+double RunningStats::stddev() const
+{
+    return std::sqrt(variance());
+}
+
+void RunningCovariance::push(double x, double y)
+{
+    // 先用旧的 x 均值求 dx，再用更新后的 y 均值求 (y - ȳ)，即 Welford 共矩更新
+    const double dx = x - sx.mean();
+    sx.push(x);
+    sy.push(y);
+    cxy += dx * (y - sy.mean());
+}
+
+void RunningCovariance::merge(const RunningCovariance &other)
+{
+    if (other.count() == 0)
+        return;
+    if (count() == 0)
+    {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(count()), nb = static_cast<double>(other.count());
+    const double total = na + nb;
+    const double dx = other.sx.mean() - sx.mean();
+    const double dy = other.sy.mean() - sy.mean();
+    cxy += other.cxy + dx * dy * na * nb / total;
+    sx.merge(other.sx);
+    sy.merge(other.sy);
+}
+
+double RunningCovariance::covariance() const
+{
+    return count() == 0 ? 0.0 : cxy / static_cast<double>(count());
+}
+
+double RunningCovariance::pearson() const
+{
+    if (count() < 2)
+        return 0.0;
+    const double vx = sx.variance(), vy = sy.variance();
+    if (vx <= 0.0 || vy <= 0.0)
+        return 0.0;
+    return covariance() / std::sqrt(vx * vy);
+}
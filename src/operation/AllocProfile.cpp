@@ -0,0 +1,228 @@
+#include "AllocProfile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+namespace {
+
+enum Field { Allocs, Bytes, Frees, FreedBytes, FieldCount };
+
+constexpr int SLOT_COUNT = AllocProfile::MAX_PHASES * AllocProfile::MAX_SITES;
+
+// 静态存储，零初始化，不依赖任何动态初始化（operator new 可能在 main 之前被调用）
+std::atomic<std::uint64_t> table[SLOT_COUNT][FieldCount];
+
+// 当前线程的最内层阶段 / 调用点；常量初始化，分配钩子中可安全读取
+thread_local int currentPhase = 0;
+thread_local int currentSite = 0;
+
+struct Names {
+    std::mutex mtx;
+    std::vector<std::string> phases{"-"};
+    std::vector<std::string> sites{"-"};
+};
+
+Names& names() {
+    static Names n;
+    return n;
+}
+
+int intern(std::vector<std::string>& list, const std::string& name, int limit) {
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (list[i] == name) return static_cast<int>(i);
+    }
+    if (static_cast<int>(list.size()) >= limit - 1) {
+        if (static_cast<int>(list.size()) == limit - 1) list.push_back("(other)");
+        return limit - 1;
+    }
+    list.push_back(name);
+    return static_cast<int>(list.size()) - 1;
+}
+
+} // namespace
+
+int AllocProfile::phaseId(const std::string& name) {
+    Names& n = names();
+    std::lock_guard<std::mutex> lk(n.mtx);
+    return intern(n.phases, name, MAX_PHASES);
+}
+
+int AllocProfile::siteId(const char* name) {
+    Names& n = names();
+    std::lock_guard<std::mutex> lk(n.mtx);
+    return intern(n.sites, name, MAX_SITES);
+}
+
+AllocProfile::Phase::Phase(const std::string& name) : prev(currentPhase) {
+    currentPhase = phaseId(name);
+}
+
+AllocProfile::Phase::~Phase() {
+    currentPhase = prev;
+}
+
+AllocProfile::Site::Site(int id) : prev(currentSite) {
+    currentSite = id;
+}
+
+AllocProfile::Site::~Site() {
+    currentSite = prev;
+}
+
+std::vector<AllocProfile::Row> AllocProfile::rows() {
+    std::vector<std::string> phaseNames, siteNames;
+    {
+        Names& n = names();
+        std::lock_guard<std::mutex> lk(n.mtx);
+        phaseNames = n.phases;
+        siteNames = n.sites;
+    }
+
+    std::vector<Row> res;
+    for (int p = 0; p < static_cast<int>(phaseNames.size()); ++p) {
+        for (int s = 0; s < static_cast<int>(siteNames.size()); ++s) {
+            const auto& slot = table[p * MAX_SITES + s];
+            Row r;
+            r.allocs = slot[Allocs].load(std::memory_order_relaxed);
+            r.frees = slot[Frees].load(std::memory_order_relaxed);
+            if (r.allocs == 0 && r.frees == 0) continue;
+            r.bytes = slot[Bytes].load(std::memory_order_relaxed);
+            r.freedBytes = slot[FreedBytes].load(std::memory_order_relaxed);
+            r.phase = phaseNames[static_cast<std::size_t>(p)];
+            r.site = siteNames[static_cast<std::size_t>(s)];
+            res.push_back(std::move(r));
+        }
+    }
+    return res;
+}
+
+void AllocProfile::reset() {
+    for (auto& slot : table) {
+        for (auto& f : slot) f.store(0, std::memory_order_relaxed);
+    }
+}
+
+void AllocProfile::report(std::ostream& os) {
+    if (!enabled) {
+        os << "allocation profiling disabled (configure with -DTRIAL_ALLOC_PROFILE=ON)\n";
+        return;
+    }
+
+    const std::vector<Row> all = rows();
+    std::map<std::string, Row> byPhase, bySite;
+    for (const Row& r : all) {
+        for (Row* agg : {&byPhase[r.phase], &bySite[r.site]}) {
+            agg->allocs += r.allocs;
+            agg->bytes += r.bytes;
+            agg->frees += r.frees;
+            agg->freedBytes += r.freedBytes;
+        }
+    }
+
+    os << "phase,site,allocs,bytes,frees,freedBytes,liveBytes\n";
+    auto row = [&os](const std::string& phase, const std::string& site, const Row& r) {
+        // 释放可能早于 reset() 之后的统计窗口，liveBytes 夹到 0
+        const std::uint64_t live = (r.bytes > r.freedBytes) ? r.bytes - r.freedBytes : 0;
+        os << phase << ',' << site << ',' << r.allocs << ',' << r.bytes << ','
+           << r.frees << ',' << r.freedBytes << ',' << live << '\n';
+    };
+    for (const Row& r : all) row(r.phase, r.site, r);
+    for (const auto& [phase, r] : byPhase) row(phase, "*", r);
+    for (const auto& [site, r] : bySite) row("*", site, r);
+}
+
+#if defined(TRIAL_ALLOC_PROFILE)
+
+// ======================== 全局 operator new / delete ========================
+// 用户指针之前放一个 Header：原始 malloc 指针（对齐分配时与用户指针不同）、请求大小、归属槽位
+
+namespace {
+
+struct Header {
+    void* raw;
+    std::size_t size;
+    int slot;
+};
+
+void* profiledAlloc(std::size_t size, std::size_t align) noexcept {
+    if (size == 0) size = 1;
+    if (align < alignof(std::max_align_t)) align = alignof(std::max_align_t);
+    const std::size_t extra = sizeof(Header) + align - 1;
+    if (size > static_cast<std::size_t>(-1) - extra) return nullptr;
+
+    void* raw = std::malloc(size + extra);
+    if (raw == nullptr) return nullptr;
+
+    const std::uintptr_t user = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(Header) + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+    Header* h = reinterpret_cast<Header*>(user) - 1;
+    h->raw = raw;
+    h->size = size;
+    h->slot = currentPhase * AllocProfile::MAX_SITES + currentSite;
+
+    table[h->slot][Allocs].fetch_add(1, std::memory_order_relaxed);
+    table[h->slot][Bytes].fetch_add(size, std::memory_order_relaxed);
+    return reinterpret_cast<void*>(user);
+}
+
+void profiledFree(void* p) noexcept {
+    if (p == nullptr) return;
+    Header* h = static_cast<Header*>(p) - 1;
+    table[h->slot][Frees].fetch_add(1, std::memory_order_relaxed);
+    table[h->slot][FreedBytes].fetch_add(h->size, std::memory_order_relaxed);
+    std::free(h->raw);
+}
+
+void* profiledNew(std::size_t size, std::size_t align) {
+    for (;;) {
+        void* p = profiledAlloc(size, align);
+        if (p != nullptr) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* profiledNewNothrow(std::size_t size, std::size_t align) noexcept {
+    try {
+        return profiledNew(size, align);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return profiledNew(size, 0); }
+void* operator new[](std::size_t size) { return profiledNew(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return profiledNewNothrow(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return profiledNewNothrow(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al) { return profiledNew(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return profiledNew(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return profiledNewNothrow(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return profiledNewNothrow(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p) noexcept { profiledFree(p); }
+void operator delete[](void* p) noexcept { profiledFree(p); }
+void operator delete(void* p, std::size_t) noexcept { profiledFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { profiledFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { profiledFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { profiledFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { profiledFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { profiledFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { profiledFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { profiledFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { profiledFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { profiledFree(p); }
+
+#endif
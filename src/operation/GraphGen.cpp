@@ -1,5 +1,7 @@
 #include "GraphGen.hpp"
 
+#include <algorithm>
+#include <numeric>
 #include <string>
 #include <stdexcept>
 
@@ -127,3 +129,29 @@ AdjListGraph GraphGen::makeBinaryTreeAdjList(int n) {
 AdjMatrixGraph GraphGen::makeBinaryTreeAdjMatrix(int n) { 
     return makeBinaryTree<AdjMatrixGraph>(n); 
 }
+
+
+CsrGraph GraphGen::makeSparseRandomCsr(size_t n, size_t avgDeg, unsigned seed) {
+    if (n == 0) throw std::invalid_argument("makeSparseRandomCsr: n must be > 0");
+
+    std::mt19937 gen(seed);
+    std::vector<Index> ids(n);
+    std::iota(ids.begin(), ids.end(), static_cast<Index>(0));
+    std::shuffle(ids.begin(), ids.end(), gen);
+
+    std::vector<std::vector<Index>> adj(n);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        adj[ids[i]].push_back(ids[i + 1]);
+        adj[ids[i + 1]].push_back(ids[i]);
+    }
+
+    std::uniform_int_distribution<Index> pick(0, static_cast<Index>(n - 1));
+    const size_t extraEdges = n * (avgDeg > 2 ? avgDeg - 2 : 0) / 2;
+    for (size_t e = 0; e < extraEdges; ++e) {
+        Index u = pick(gen), v = pick(gen);
+        if (u == v) continue;
+        adj[u].push_back(v);
+        adj[v].push_back(u);
+    }
+    return CsrGraph::fromAdjacency(adj);
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Instrument.hpp"
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+struct PhaseRecord {
+    std::string name;
+    std::uint64_t calls = 0;
+    Instrument::Snapshot delta;
+};
+
+// 各线程的计数块与已记录的阶段
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<Instrument::Block>> blocks;
+    std::vector<PhaseRecord> phases;
+};
+
+Registry& registry() {
+    static Registry reg;
+    return reg;
+}
+
+} // namespace
+
+Instrument::Block* Instrument::registerThread() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    reg.blocks.push_back(std::unique_ptr<Block>(new Block()));
+    threadBlock = reg.blocks.back().get();
+    return threadBlock;
+}
+
+Instrument::Snapshot Instrument::total() {
+    Snapshot s;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    for (const auto& b : reg.blocks) {
+        for (int c = 0; c < CounterCount; ++c) s.value[c] += b->value[c].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void Instrument::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    for (const auto& b : reg.blocks) {
+        for (int c = 0; c < CounterCount; ++c) b->value[c].store(0, std::memory_order_relaxed);
+    }
+    reg.phases.clear();
+}
+
+const char* Instrument::name(Counter c) {
+    switch (c) {
+    case NeighborCalls: return "neighborCalls";
+    case NeighborCopies: return "neighborCopies";
+    case NodeCopies: return "nodeCopies";
+    case VisitedChecks: return "visitedChecks";
+    case Pushes: return "pushes";
+    case Pops: return "pops";
+    case RankStates: return "rankStates";
+    case RankMemoPrunes: return "rankMemoPrunes";
+    case RankBranches: return "rankBranches";
+    default: return "unknown";
+    }
+}
+
+void Instrument::report(std::ostream& os) {
+    if (!enabled) {
+        os << "instrumentation disabled (configure with -DTRIAL_INSTRUMENT=ON)\n";
+        return;
+    }
+
+    std::vector<PhaseRecord> phases;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lk(reg.mtx);
+        phases = reg.phases;
+    }
+    PhaseRecord all;
+    all.name = "total";
+    all.delta = total();
+
+    os << "phase,calls";
+    for (int c = 0; c < CounterCount; ++c) os << ',' << name(static_cast<Counter>(c));
+    os << '\n';
+    auto row = [&os](const PhaseRecord& p) {
+        os << p.name << ',' << p.calls;
+        for (int c = 0; c < CounterCount; ++c) os << ',' << p.delta.value[c];
+        os << '\n';
+    };
+    for (const PhaseRecord& p : phases) row(p);
+    row(all);
+}
+
+Instrument::Phase::Phase(std::string name) : phaseName(std::move(name)), start(total()) {}
+
+Instrument::Phase::~Phase() {
+    const Snapshot end = total();
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    PhaseRecord* rec = nullptr;
+    for (PhaseRecord& p : reg.phases) {
+        if (p.name == phaseName) { rec = &p; break; }
+    }
+    if (rec == nullptr) {
+        reg.phases.push_back(PhaseRecord());
+        rec = &reg.phases.back();
+        rec->name = phaseName;
+    }
+    rec->calls += 1;
+    for (int c = 0; c < CounterCount; ++c) rec->delta.value[c] += end.value[c] - start.value[c];
+}
@@ -0,0 +1,106 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace {
+// 标记当前线程是否正在执行某个 parallelFor 的分块（用于嵌套调用时退化为串行）
+thread_local bool insideJob = false;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers.reserve(threads - 1);
+    for (unsigned id = 1; id < threads; ++id) {
+        workers.emplace_back([this, id] { workerLoop(id); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::runChunks(unsigned id) {
+    const bool outer = insideJob;
+    insideJob = true;
+    try {
+        while (true) {
+            const std::size_t begin = nextBegin.fetch_add(jobGrain);
+            if (begin >= jobCount) break;
+            const std::size_t end = std::min(jobCount, begin + jobGrain);
+            (*job)(id, begin, end);
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (!firstError) firstError = std::current_exception();
+        nextBegin.store(jobCount); // 让其余 worker 尽快结束
+    }
+    insideJob = outer;
+}
+
+void ThreadPool::workerLoop(unsigned id) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(mtx);
+            wake.wait(lk, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (id >= jobWorkers) continue;
+        }
+
+        runChunks(id);
+
+        std::lock_guard<std::mutex> lk(mtx);
+        if (--pending == 0) done.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain,
+                             const std::function<void(unsigned, std::size_t, std::size_t)>& fn,
+                             unsigned maxWorkers) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+
+    unsigned use = size();
+    if (maxWorkers > 0) use = std::min(use, maxWorkers);
+    if (use <= 1 || insideJob || count <= grain) {
+        fn(0, 0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex);
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        job = &fn;
+        jobCount = count;
+        jobGrain = grain;
+        jobWorkers = use;
+        nextBegin.store(0);
+        pending = use - 1;
+        firstError = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runChunks(0);
+
+    std::exception_ptr err;
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        done.wait(lk, [&] { return pending == 0; });
+        job = nullptr;
+        err = firstError;
+        firstError = nullptr;
+    }
+    if (err) std::rethrow_exception(err);
+}
@@ -0,0 +1,196 @@
+#include "Tracer.hpp"
+#include "Constants.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<Tracer::ThreadBuffer>> buffers;
+    std::int64_t epochNs = 0;
+};
+
+Registry& registry() {
+    static Registry reg;
+    return reg;
+}
+
+void writeJsonString(std::ofstream& ofs, const std::string& s) {
+    ofs << '"';
+    for (unsigned char c : s) {
+        switch (c) {
+        case '"': ofs << "\\\""; break;
+        case '\\': ofs << "\\\\"; break;
+        case '\n': ofs << "\\n"; break;
+        case '\r': ofs << "\\r"; break;
+        case '\t': ofs << "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                ofs << buf;
+            } else {
+                ofs << static_cast<char>(c);
+            }
+        }
+    }
+    ofs << '"';
+}
+
+// trace 的时间单位为微秒；保留到纳秒
+void writeMicros(std::ofstream& ofs, std::int64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                  static_cast<long long>(ns % 1000));
+    ofs << buf;
+}
+
+} // namespace
+
+std::int64_t Tracer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Tracer::ThreadBuffer* Tracer::registerThread() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    reg.buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+    threadBuffer = reg.buffers.back().get();
+    threadBuffer->tid = static_cast<int>(reg.buffers.size());
+    return threadBuffer;
+}
+
+void Tracer::start() {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lk(reg.mtx);
+        for (auto& b : reg.buffers) {
+            std::lock_guard<std::mutex> blk(b->mtx);
+            b->events.clear();
+            b->dropped = 0;
+        }
+        reg.epochNs = nowNs();
+    }
+    enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() {
+    enabled.store(false, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer* b = threadBuffer;
+    if (b == nullptr) b = registerThread();
+    std::lock_guard<std::mutex> lk(registry().mtx);
+    b->name = name;
+}
+
+void Tracer::record(const char* category, const char* staticName, std::string&& dynamicName,
+                    std::int64_t startNs, std::int64_t endNs) {
+    ThreadBuffer* b = threadBuffer;
+    if (b == nullptr) b = registerThread();
+    std::lock_guard<std::mutex> lk(b->mtx);
+    if (b->events.size() >= TRACE_MAX_EVENTS_PER_THREAD) {
+        ++b->dropped;
+        return;
+    }
+    Event e;
+    e.category = category;
+    e.staticName = staticName;
+    if (staticName == nullptr) e.dynamicName = std::move(dynamicName);
+    e.startNs = startNs;
+    e.durNs = endNs - startNs;
+    b->events.push_back(std::move(e));
+}
+
+std::size_t Tracer::eventCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    std::size_t total = 0;
+    for (const auto& b : reg.buffers) {
+        std::lock_guard<std::mutex> blk(b->mtx);
+        total += b->events.size();
+    }
+    return total;
+}
+
+std::size_t Tracer::droppedCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+    std::size_t total = 0;
+    for (const auto& b : reg.buffers) {
+        std::lock_guard<std::mutex> blk(b->mtx);
+        total += b->dropped;
+    }
+    return total;
+}
+
+void Tracer::writeJson(const std::string& path) {
+    std::ofstream ofs(path);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mtx);
+
+    std::size_t dropped = 0;
+    bool first = true;
+    auto sep = [&]() {
+        ofs << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    sep();
+    ofs << "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"TRIAL\"}}";
+    for (const auto& b : reg.buffers) {
+        std::lock_guard<std::mutex> blk(b->mtx);
+        dropped += b->dropped;
+        if (!b->name.empty()) {
+            sep();
+            ofs << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            writeJsonString(ofs, b->name);
+            ofs << "}}";
+        }
+        for (const Event& e : b->events) {
+            sep();
+            ofs << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid << ",\"cat\":";
+            writeJsonString(ofs, e.category);
+            ofs << ",\"name\":";
+            writeJsonString(ofs, (e.staticName != nullptr) ? std::string(e.staticName) : e.dynamicName);
+            ofs << ",\"ts\":";
+            writeMicros(ofs, e.startNs - reg.epochNs);
+            ofs << ",\"dur\":";
+            writeMicros(ofs, e.durNs);
+            ofs << '}';
+        }
+    }
+    ofs << "\n],\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+}
+
+Tracer::Span::Span(const char* category, const char* name)
+    : category(category), staticName(name) {
+    if (active()) startNs = nowNs();
+}
+
+Tracer::Span::Span(const char* category, std::string name)
+    : category(category), staticName(nullptr) {
+    if (active()) {
+        dynamicName = std::move(name);
+        startNs = nowNs();
+    }
+}
+
+Tracer::Span::~Span() {
+    if (startNs < 0 || !active()) return;
+    record(category, staticName, std::move(dynamicName), startNs, nowNs());
+}
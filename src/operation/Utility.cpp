@@ -1,8 +1,11 @@
 #include "Utility.hpp"
 #include "Metrics.hpp"
+#include "Tracer.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <filesystem>
+#include <stdexcept>
 
 namespace {
     static std::string csvEscape(const std::string& s) {
@@ -20,12 +23,45 @@ namespace {
         return out;
     }
 
+    // 拆分一行 CSV（支持 csvEscape 产生的双引号字段）
+    static void splitCsvLine(const std::string& line, std::vector<std::string>& fields) {
+        fields.clear();
+        std::string cur;
+        bool quoted = false;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            const char c = line[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') { cur.push_back('"'); ++i; }
+                else if (c == '"') quoted = false;
+                else cur.push_back(c);
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.push_back(cur);
+                cur.clear();
+            } else if (c != '\r') {
+                cur.push_back(c);
+            }
+        }
+        fields.push_back(cur);
+    }
+
     static bool fileIsEmptyOrMissing(const std::string& path) {
         std::ifstream ifs(path, std::ios::binary);
         if (!ifs.is_open()) return true;
         ifs.seekg(0, std::ios::end);
         return ifs.tellg() == 0;
     }
+
+    static std::string firstLineOf(const std::string& path) {
+        std::ifstream ifs(path);
+        std::string line;
+        std::getline(ifs, line);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        return line;
+    }
+
+    const char* const RES_HEADER = "label,bfsMaxQueue,dfsMaxStack,bfsHDS,dfsHDS,bfsBS,dfsBS,bfsCacheMiss,dfsCacheMiss";
 } // anonymous namespace
 
 void Utility::extractGraphInfo(
@@ -47,26 +83,30 @@ void Utility::extractGraphInfo(
 }
 
 MetricsResStorage Utility::doSpaceMeasure(Graph& graph) {
-    RootOptResult dfsMaxStack = Metrics::measureDFSMaxStack(graph);
-    RootOptResult bfsMaxQueue = Metrics::measureBFSMaxQueue(graph);
-    double bfsHDS = Metrics::measureHighDegreeSpacing(graph, TraversalAlgo::bfsTrace);
-    double dfsHDS = Metrics::measureHighDegreeSpacing(graph, TraversalAlgo::dfsTrace);
-    double bfsBS  = Metrics::measureBranchSuspension(graph, TraversalAlgo::bfsTrace);
-    double dfsBS  = Metrics::measureBranchSuspension(graph, TraversalAlgo::dfsTrace);
+    SpaceMetrics m = Metrics::measureSpaceMetrics(graph);
 
     MetricsResStorage res;
-    res.append(bfsMaxQueue, dfsMaxStack, bfsHDS, dfsHDS ,bfsBS, dfsBS, graph.getLabel());
+    res.append(m.bfsMaxQueue, m.dfsMaxStack, m.bfsHDS, m.dfsHDS, m.bfsBS, m.dfsBS, m.bfsCacheMiss, m.dfsCacheMiss, graph.getLabel());
     return res;
 }
 
+void Utility::checkResHeader(const std::string& path) {
+    // 追加到已有文件时表头必须一致，否则新行与旧表头的列数 / 含义对不上
+    if (!fileIsEmptyOrMissing(path) && firstLineOf(path) != RES_HEADER) {
+        throw std::runtime_error("Result file has a different header (remove or rename it): " + path);
+    }
+}
+
 void Utility::saveRes(const std::string& path, const MetricsResStorage& res) {
+    TRIAL_TRACE_SPAN("Storage", "Utility::saveRes");
+    checkResHeader(path);
     const bool needHeader = fileIsEmptyOrMissing(path);
 
     std::ofstream ofs(path, std::ios::out | std::ios::app);
     if (!ofs.is_open()) return;
 
     if (needHeader) {
-        ofs << "label,bfsMaxQueue,dfsMaxStack,bfsHDS,dfsHDS,bfsBS,dfsBS\n";
+        ofs << RES_HEADER << '\n';
     }
     ofs << std::setprecision(17);
 
@@ -78,10 +118,13 @@ void Utility::saveRes(const std::string& path, const MetricsResStorage& res) {
     const auto& dfsH   = res.getDfsHDS();
     const auto& bfsB   = res.getBfsBS();
     const auto& dfsB   = res.getDfsBS();
+    const auto& bfsC   = res.getBfsCacheMiss();
+    const auto& dfsC   = res.getDfsCacheMiss();
 
     // 防御性检查：不一致直接不写
     if (labels.size() != n || bfsQ.size() != n || dfsS.size() != n ||
-        bfsH.size()   != n || dfsH.size() != n || bfsB.size() != n || dfsB.size() != n) {
+        bfsH.size()   != n || dfsH.size() != n || bfsB.size() != n || dfsB.size() != n ||
+        bfsC.size()   != n || dfsC.size() != n) {
         return;
     }
 
@@ -92,8 +135,43 @@ void Utility::saveRes(const std::string& path, const MetricsResStorage& res) {
             << bfsH[i] << ','
             << dfsH[i] << ','
             << bfsB[i] << ','
-            << dfsB[i] << '\n';
+            << dfsB[i] << ','
+            << bfsC[i] << ','
+            << dfsC[i] << '\n';
     }
 
     ofs.flush();
-}
\ No newline at end of file
+}
+
+std::map<std::string, RunningCovariance> Utility::correlateResColumns(
+    const std::string& path, const std::string& colX, const std::string& colY) {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        throw std::runtime_error("Failed to open result file: " + path);
+    }
+
+    std::string line;
+    std::vector<std::string> fields;
+    if (!std::getline(ifs, line)) return {};
+    splitCsvLine(line, fields);
+
+    auto column = [&fields, &path](const std::string& name) {
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i] == name) return i;
+        }
+        throw std::runtime_error("Column " + name + " not found in: " + path);
+    };
+    const std::size_t li = column("label");
+    const std::size_t xi = column(colX);
+    const std::size_t yi = column(colY);
+    const std::size_t need = std::max(li, std::max(xi, yi));
+
+    std::map<std::string, RunningCovariance> res;
+    while (std::getline(ifs, line)) {
+        if (line.empty()) continue;
+        splitCsvLine(line, fields);
+        if (fields.size() <= need) continue; // 截断的行（例如写入中断）
+        res[fields[li]].push(std::stod(fields[xi]), std::stod(fields[yi]));
+    }
+    return res;
+}
@@ -1,14 +1,16 @@
-//对于一张十分简单的图，测量其平均遍历时间
+//对于一张十分简单的图，测量其遍历时间（Benchmark：预热、校准、交错采样，报告中位数）
+// 用法: Trial_1 [pinCpu=-1] [csvPath]（csvPath 非空时写出每个配置的计时与硬件计数）
+#include <cstdlib>
 #include <iostream>
 #include <vector>
-#include <limits>
+#include <string>
 #include "AdjListGraph.hpp"
 #include "AdjMatrixGraph.hpp"
 #include "TraversalAlgo.hpp"
 #include "ReGraph.hpp"
-#include "Metrics.hpp"
+#include "Benchmark.hpp"
 
-int main() {
+int main(int argc, char** argv) {
     using namespace std;
 
     // 构造邻接表图（无向图：双向加边）
@@ -47,81 +49,66 @@ int main() {
     cout << "AdjList permutations:   " << listGraphs.size()   << "\n";
     cout << "AdjMatrix permutations: " << matrixGraphs.size() << "\n\n";
 
-    int repeatTimes = 100000;  // 重复次数，越大越稳定
+    // 4 组（表示 × 算法）× 24 个重排共 96 个配置放进同一个 Benchmark（返回 trace，由 doNotOptimize 使用），
+    // 各配置先预热、校准，再逐轮随机交错采样，取每个配置的中位数
+    BenchOptions opt;
+    if (argc >= 2) opt.pinCpu = atoi(argv[1]); // 可选：绑定到指定 CPU
+    opt.perfCounters = true;                    // 硬件计数器不可用时自动只计时
+    Benchmark bench(opt);
 
-    // 工具函数：打印 min / max / avg
-    auto printStats = [](const string& title, const vector<double>& v) {
+    const char* groups[] = {"AdjList BFS", "AdjList DFS", "AdjMatrix BFS", "AdjMatrix DFS"};
+    for (size_t i = 0; i < listGraphs.size(); ++i) {
+        Graph* g = &listGraphs[i];
+        bench.add(string(groups[0]) + "#" + to_string(i), [g] { return TraversalAlgo::bfsTrace(*g); });
+        bench.add(string(groups[1]) + "#" + to_string(i), [g] { return TraversalAlgo::dfsTrace(*g); });
+    }
+    for (size_t i = 0; i < matrixGraphs.size(); ++i) {
+        Graph* g = &matrixGraphs[i];
+        bench.add(string(groups[2]) + "#" + to_string(i), [g] { return TraversalAlgo::bfsTrace(*g); });
+        bench.add(string(groups[3]) + "#" + to_string(i), [g] { return TraversalAlgo::dfsTrace(*g); });
+    }
+    const vector<BenchSummary> res = bench.run();
+    cout << "perf counters: " << bench.perfStatus() << "\n\n";
+    if (argc >= 3) Benchmark::writeCsv(argv[2], res);
+
+    // 工具函数：打印一组重排的中位数的 min / max / avg，以及最快 / 最慢重排的 MAD
+    auto printStats = [&res](const string& title) {
+        vector<const BenchSummary*> v;
+        for (const BenchSummary& s : res) {
+            if (s.name.compare(0, title.size() + 1, title + "#") == 0) v.push_back(&s);
+        }
         if (v.empty()) {
             cout << title << ": empty\n\n";
             return;
         }
-        double mn = numeric_limits<double>::max();
-        double mx = numeric_limits<double>::lowest();
-        double sum = 0.0;
         size_t idx_min = 0, idx_max = 0;
-
+        double sum = 0.0;
         for (size_t i = 0; i < v.size(); ++i) {
-            double x = v[i];
-            sum += x;
-            if (x < mn) { mn = x; idx_min = i; }
-            if (x > mx) { mx = x; idx_max = i; }
+            sum += v[i]->median;
+            if (v[i]->median < v[idx_min]->median) idx_min = i;
+            if (v[i]->median > v[idx_max]->median) idx_max = i;
         }
         cout << title << ":\n";
-        cout << "  count = " << v.size() << "\n";
-        cout << "  min   = " << mn << " ns (perm index = " << idx_min << ")\n";
-        cout << "  max   = " << mx << " ns (perm index = " << idx_max << ")\n";
-        cout << "  avg   = " << (sum / v.size()) << " ns\n\n";
+        cout << "  count = " << v.size() << " (iters/sample = " << v[idx_min]->itersPerSample << ")\n";
+        cout << "  min   = " << v[idx_min]->median << " ns (perm index = " << idx_min
+             << ", MAD = " << v[idx_min]->mad << ", p95 = " << v[idx_min]->percentile(0.95) << ")\n";
+        cout << "  max   = " << v[idx_max]->median << " ns (perm index = " << idx_max
+             << ", MAD = " << v[idx_max]->mad << ", p95 = " << v[idx_max]->percentile(0.95) << ")\n";
+        cout << "  avg   = " << (sum / v.size()) << " ns (mean of medians)\n";
+        const PerfCounts& pc = v[idx_max]->counters;
+        if (pc.valid()) {
+            cout << "  slowest perm / iter:";
+            for (int e = 0; e < PerfCounts::EventCount; ++e) {
+                if (pc.has(static_cast<PerfCounts::Event>(e)))
+                    cout << " " << PerfCounts::name(static_cast<PerfCounts::Event>(e)) << "=" << pc.value[e];
+            }
+            cout << "\n";
+        }
+        cout << "\n";
     };
 
-    // 邻接表 BFS
-    vector<double> listBfsRes;
-    listBfsRes.reserve(listGraphs.size());
-    for (auto& graph : listGraphs) {
-        listBfsRes.push_back(Metrics::measureAveTraverlsalTime(
-            graph,
-            [](Graph& g) { TraversalAlgo::bfs(g); },
-            repeatTimes
-        ));
-    }
-
-    // 邻接表 DFS
-    vector<double> listDfsRes;
-    listDfsRes.reserve(listGraphs.size());
-    for (auto& graph : listGraphs) {
-        listDfsRes.push_back(Metrics::measureAveTraverlsalTime(
-            graph,
-            [](Graph& g) { TraversalAlgo::dfs(g); },
-            repeatTimes
-        ));
-    }
-
-    // 邻接矩阵 DFS
-    vector<double> matrixDfsRes;
-    matrixDfsRes.reserve(matrixGraphs.size());
-    for (auto& graph : matrixGraphs) {
-        matrixDfsRes.push_back(Metrics::measureAveTraverlsalTime(
-            graph,
-            [](Graph& g) { TraversalAlgo::dfs(g); },
-            repeatTimes
-        ));
-    }
-
-    // 邻接矩阵 BFS
-    vector<double> matrixBfsRes;
-    matrixBfsRes.reserve(matrixGraphs.size());
-    for (auto& graph : matrixGraphs) {
-        matrixBfsRes.push_back(Metrics::measureAveTraverlsalTime(
-            graph,
-            [](Graph& g) { TraversalAlgo::bfs(g); },
-            repeatTimes
-        ));
-    }
-
     // 输出统计结果
-    printStats("AdjList BFS",   listBfsRes);
-    printStats("AdjList DFS",   listDfsRes);
-    printStats("AdjMatrix BFS", matrixBfsRes);
-    printStats("AdjMatrix DFS", matrixDfsRes);
+    for (const char* title : groups) printStats(title);
 
     return 0;
 }
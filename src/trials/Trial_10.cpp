@@ -0,0 +1,135 @@
+// 比较“有界内存遍历模式”（IDDFS、限队列 BFS）与“重排存储结构”（BestSpaceConstruction）
+// 两条降低遍历空间占用的路线：各自的峰值、额外工作量（邻接表扫描次数）以及时间代价
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BestSpaceConstruction.hpp"
+#include "GraphGen.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+namespace
+{
+    struct ModeResult
+    {
+        string mode;
+        size_t peak = 0;
+        size_t expansions = 0;
+        double ns = 0.0;
+    };
+
+    template <typename Func>
+    double timeNs(Func f, int repeat)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto t0 = Clock::now();
+        for (int i = 0; i < repeat; ++i)
+            f();
+        auto t1 = Clock::now();
+        return static_cast<double>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+               repeat;
+    }
+
+    void printRow(const string &caseName, const ModeResult &r)
+    {
+        cout << caseName << "," << r.mode << "," << r.peak << "," << r.expansions << "," << r.ns << "\n";
+    }
+
+    void runCase(const string &caseName, AdjListGraph &g, int repeat)
+    {
+        const size_t n = g.getNodeCount();
+        vector<string> order;
+
+        // 1) 标准 BFS / Path-DFS（expansions 恰为 n）
+        ModeResult bfs{"BFS"};
+        bfs.peak = Metrics::measureBFSMaxQueueFromRoot(g, order, ROOT);
+        bfs.expansions = n;
+        bfs.ns = timeNs([&]
+                        { Metrics::measureBFSMaxQueueFromRoot(g, order, ROOT); }, repeat);
+        printRow(caseName, bfs);
+
+        ModeResult dfs{"PathDFS"};
+        dfs.peak = Metrics::measureDFSMaxStackFromRoot(g, order, ROOT);
+        dfs.expansions = n;
+        dfs.ns = timeNs([&]
+                        { Metrics::measureDFSMaxStackFromRoot(g, order, ROOT); }, repeat);
+        printRow(caseName, dfs);
+
+        // 2) 有界内存模式
+        ModeResult iddfs{"IDDFS"};
+        iddfs.peak = Metrics::measureIDDFSMaxStackFromRoot(g, order, ROOT, iddfs.expansions);
+        iddfs.ns = timeNs([&]
+                          { size_t e; Metrics::measureIDDFSMaxStackFromRoot(g, order, ROOT, e); }, repeat);
+        printRow(caseName, iddfs);
+
+        for (size_t div : {2, 4, 16})
+        {
+            const size_t budget = std::max<size_t>(1, bfs.peak / div);
+            ModeResult capped{"CappedBFS(budget=" + to_string(budget) + ")"};
+            capped.peak = Metrics::measureCappedBFSMaxQueueFromRoot(g, order, ROOT, budget, capped.expansions);
+            capped.ns = timeNs([&]
+                               { size_t e; Metrics::measureCappedBFSMaxQueueFromRoot(g, order, ROOT, budget, e); },
+                               repeat);
+            printRow(caseName, capped);
+        }
+
+        // 3) 重排路线：一次性构造代价 + 重排后标准遍历的峰值
+        AdjListGraph best;
+        const double buildNs = timeNs([&]
+                                      { best = BestSpaceConstruction::getBestSpaceConstruction(g); }, 1);
+
+        ModeResult bestBfs{"Reordered+BFS"};
+        bestBfs.peak = Metrics::measureBFSMaxQueueFromRoot(best, order, ROOT);
+        bestBfs.expansions = n;
+        bestBfs.ns = timeNs([&]
+                            { Metrics::measureBFSMaxQueueFromRoot(best, order, ROOT); }, repeat);
+        printRow(caseName, bestBfs);
+
+        ModeResult bestDfs{"Reordered+PathDFS"};
+        bestDfs.peak = Metrics::measureDFSMaxStackFromRoot(best, order, ROOT);
+        bestDfs.expansions = n;
+        bestDfs.ns = timeNs([&]
+                            { Metrics::measureDFSMaxStackFromRoot(best, order, ROOT); }, repeat);
+        printRow(caseName, bestDfs);
+
+        cout << caseName << ",ReorderBuild(one-off),0,0," << buildNs << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 20;
+    if (argc >= 2)
+    {
+        int x = std::atoi(argv[1]);
+        if (x > 0)
+            repeat = x;
+    }
+
+    cout << "===== Trial_10: Memory-bounded traversal vs. reordering =====\n";
+    cout << "repeat = " << repeat << "\n\n";
+    cout << "case,mode,peak,expansions,ns\n";
+
+    AdjListGraph tree = GraphGen::makeBinaryTreeAdjList(255);
+    runCase("BinaryTree(255)", tree, repeat);
+
+    AdjListGraph star = GraphGen::makeStarAdjList(200);
+    runCase("Star(200)", star, repeat);
+
+    AdjListGraph grid = GraphGen::makeGridAdjList(16, 16);
+    runCase("Grid(16x16)", grid, repeat);
+
+    AdjListGraph clique = GraphGen::makeCliqueTailAdjList(30, 100);
+    runCase("CliqueTail(30,100)", clique, repeat);
+
+    AdjListGraph random = GraphGen::makeGraph<AdjListGraph>(200, 0.05);
+    runCase("G(200,0.05)", random, repeat);
+
+    return 0;
+}
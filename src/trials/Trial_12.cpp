@@ -0,0 +1,88 @@
+// 访问秩集合的两两相似度矩阵（SimilarityMatrix）：读取 Trial_7 / Trial_8 写出的分布 CSV，
+// 取全部或某个空间占用（key）下的访问秩，并行计算 Kendall / LCS 相似度，
+// 流式写成二进制矩阵（scripts/read_similarity_matrix.py 读取），可选输出每行 top-k
+//
+// 用法:
+//   Trial_12 <distribution.csv> <kendall|lcs> <out.bin> [key=all] [topK=0]
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DistributionStorage.hpp"
+#include "SimilarityMatrix.hpp"
+
+using namespace std;
+
+namespace
+{
+    static inline long long msSince(const std::chrono::steady_clock::time_point &t0)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - t0)
+            .count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <distribution.csv> <kendall|lcs> <out.bin> [key=all] [topK=0]"
+                  << std::endl;
+        return 1;
+    }
+
+    const string kindName = argv[2];
+    if (kindName != "kendall" && kindName != "lcs")
+    {
+        std::cerr << "Unknown similarity: " << kindName << std::endl;
+        return 1;
+    }
+    const SimilarityMatrix::Kind kind =
+        (kindName == "kendall") ? SimilarityMatrix::Kind::Kendall : SimilarityMatrix::Kind::LCS;
+    const string outPath = argv[3];
+    const string keyArg = (argc >= 5) ? argv[4] : "all";
+    const size_t topK = (argc >= 6) ? static_cast<size_t>(std::stoull(argv[5])) : 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    DistributionStorage dist = DistributionStorage::fromCsv(argv[1]);
+
+    vector<vector<string>> ranks;
+    for (const auto &[key, bucket] : dist.getDistribution())
+    {
+        if (keyArg != "all" && key != static_cast<size_t>(std::stoull(keyArg)))
+            continue;
+        ranks.insert(ranks.end(), bucket.begin(), bucket.end());
+    }
+    std::cout << "[Trial_12] loaded " << ranks.size() << " ranks (key=" << keyArg
+              << ") elapsed=" << msSince(t0) << "ms" << std::endl;
+
+    t0 = std::chrono::steady_clock::now();
+    SimilarityMatrix matrix(ranks);
+    matrix.writeBinary(outPath, kind);
+    std::cout << "[Trial_12] wrote " << outPath << " (" << ranks.size() << "x" << ranks.size() << ", "
+              << kindName << ") elapsed=" << msSince(t0) << "ms" << std::endl;
+
+    if (topK > 0)
+    {
+        t0 = std::chrono::steady_clock::now();
+        const string topPath = outPath + ".top" + std::to_string(topK) + ".csv";
+        std::ofstream ofs(topPath);
+        if (!ofs.is_open())
+        {
+            std::cerr << "Failed to open " << topPath << std::endl;
+            return 1;
+        }
+        ofs << "rank,neighbor,similarity\n";
+        const auto top = matrix.topK(kind, topK);
+        for (size_t i = 0; i < top.size(); ++i)
+        {
+            for (const auto &[j, s] : top[i])
+                ofs << i << "," << j << "," << s << "\n";
+        }
+        std::cout << "[Trial_12] wrote " << topPath << " elapsed=" << msSince(t0) << "ms" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+// 并发吞吐扩展性：K = 1..maxThreads 个线程同时反复做 BFS，比较邻接表 / 邻接矩阵 / CSR 三种表示
+// 在“共享同一张图”与“每线程私有副本”两种方式下的总吞吐与单次耗时分布，观察内存带宽何时饱和
+//
+// 用法: Trial_13 [n=20000] [avgDeg=8] [durationMs=300] [maxThreads=hardware_concurrency] [pinBase=-1]
+// 邻接矩阵为 n^2 存储，n 超过 MATRIX_MAX_NODES 时跳过
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GraphGen.hpp"
+#include "TraversalAlgo.hpp"
+
+using namespace std;
+
+namespace
+{
+    const size_t MATRIX_MAX_NODES = 8192;
+
+    template <typename G>
+    G fromCsr(const CsrGraph &csr)
+    {
+        G g;
+        const Index n = static_cast<Index>(csr.getNodeCount());
+        for (Index u = 0; u < n; ++u)
+            g.addNode(Node(u, to_string(u)));
+        for (Index u = 0; u < n; ++u)
+        {
+            for (const Index *p = csr.neighborsBegin(u); p != csr.neighborsEnd(u); ++p)
+                g.addEdge(u, *p);
+        }
+        return g;
+    }
+
+    // 与 CSR 所用的 TraversalAlgo::bfsTracePrefetch(csr, 0)（distance = 0 即不预取）相同的内核：order 兼作队列、稠密 visited 数组，
+    // 只是邻居经 Graph::getNeighbors 取得，使三种表示的差异只来自邻接的存取方式
+    TraversalTrace denseBfs(const Graph &graph)
+    {
+        TraversalTrace t;
+        const int n = static_cast<int>(graph.getNodeCount());
+        if (n <= 0)
+            return t;
+
+        t.parent.assign(n, -1);
+        t.order.reserve(n);
+        vector<uint8_t> visited(n, 0);
+        t.order.push_back(ROOT);
+        visited[ROOT] = 1;
+        for (size_t head = 0; head < t.order.size(); ++head)
+        {
+            const Index cur = t.order[head];
+            for (Index adj : graph.getNeighbors(cur))
+            {
+                if (!visited[adj])
+                {
+                    visited[adj] = 1;
+                    t.parent[static_cast<size_t>(adj)] = cur;
+                    t.order.push_back(adj);
+                }
+            }
+        }
+        return t;
+    }
+
+    // 一种表示：shared 为所有线程共享的对象；makePrivate 在调用线程内构造一份私有副本并返回其操作
+    struct Repr
+    {
+        string name;
+        function<void()> sharedOp;
+        function<function<void()>()> makePrivate;
+    };
+
+    void runRepr(const Repr &repr, unsigned maxThreads, const ThroughputOptions &base)
+    {
+        for (int mode = 0; mode < 2; ++mode)
+        {
+            const bool priv = (mode == 1);
+            double single = 0.0;
+            for (unsigned k = 1; k <= maxThreads; ++k)
+            {
+                ThroughputOptions opt = base;
+                opt.threads = k;
+                ThroughputResult r = Benchmark::measureThroughput(
+                    [&](unsigned) -> function<void()>
+                    { return priv ? repr.makePrivate() : repr.sharedOp; },
+                    opt);
+
+                const LatencyHistogram &lat = r.latency; // 全部线程合并后的单次耗时分布
+
+                if (k == 1)
+                    single = r.opsPerSec;
+                const double speedup = (single > 0.0) ? r.opsPerSec / single : 0.0;
+                cout << repr.name << ',' << (priv ? "private" : "shared") << ',' << k << ','
+                     << r.totalOps << ',' << r.opsPerSec << ',' << speedup << ',' << speedup / k << ','
+                     << lat.percentile(0.5) << ',' << lat.percentile(0.9) << ',' << lat.percentile(0.99) << ','
+                     << lat.percentile(0.999) << ',' << lat.max() << '\n';
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = (argc >= 2) ? static_cast<size_t>(atoll(argv[1])) : 20000;
+    size_t avgDeg = (argc >= 3) ? static_cast<size_t>(atoi(argv[2])) : 8;
+    double durationMs = (argc >= 4) ? atof(argv[3]) : 300.0;
+    unsigned maxThreads = (argc >= 5) ? static_cast<unsigned>(atoi(argv[4])) : thread::hardware_concurrency();
+    int pinBase = (argc >= 6) ? atoi(argv[5]) : -1;
+    if (n < 16)
+        n = 16;
+    if (durationMs <= 0.0)
+        durationMs = 300.0;
+    if (maxThreads == 0)
+        maxThreads = 1;
+
+    ThroughputOptions base;
+    base.durationMs = durationMs;
+    base.pinBase = pinBase;
+
+    const CsrGraph csr = GraphGen::makeSparseRandomCsr(n, avgDeg, 20240701u);
+    auto list = make_shared<AdjListGraph>(fromCsr<AdjListGraph>(csr));
+
+    vector<Repr> reprs;
+    reprs.push_back({"AdjList",
+                     [list]
+                     { Benchmark::doNotOptimize(denseBfs(*list)); },
+                     [list]() -> function<void()>
+                     {
+                         auto g = make_shared<AdjListGraph>(*list);
+                         return [g]
+                         { Benchmark::doNotOptimize(denseBfs(*g)); };
+                     }});
+    if (n <= MATRIX_MAX_NODES)
+    {
+        auto matrix = make_shared<AdjMatrixGraph>(fromCsr<AdjMatrixGraph>(csr));
+        reprs.push_back({"AdjMatrix",
+                         [matrix]
+                         { Benchmark::doNotOptimize(denseBfs(*matrix)); },
+                         [matrix]() -> function<void()>
+                         {
+                             auto g = make_shared<AdjMatrixGraph>(*matrix);
+                             return [g]
+                             { Benchmark::doNotOptimize(denseBfs(*g)); };
+                         }});
+    }
+    reprs.push_back({"Csr",
+                     [csr]
+                     { Benchmark::doNotOptimize(TraversalAlgo::bfsTracePrefetch(csr, 0)); },
+                     [&csr]() -> function<void()>
+                     {
+                         // CsrGraph 的拷贝共享底层数组，私有副本需重新构建
+                         vector<vector<Index>> adj(csr.getNodeCount());
+                         for (size_t u = 0; u < adj.size(); ++u)
+                             adj[u].assign(csr.neighborsBegin(static_cast<Index>(u)), csr.neighborsEnd(static_cast<Index>(u)));
+                         CsrGraph g = CsrGraph::fromAdjacency(adj);
+                         return [g]
+                         { Benchmark::doNotOptimize(TraversalAlgo::bfsTracePrefetch(g, 0)); };
+                     }});
+
+    cout << "===== Trial_13: Throughput scaling of concurrent BFS =====\n";
+    cout << "n = " << n << ", m = " << csr.getEdgeCount() << ", durationMs = " << durationMs
+         << ", maxThreads = " << maxThreads << "\n\n";
+    cout << "repr,graph,threads,ops,opsPerSec,speedup,efficiency,p50Ns,p90Ns,p99Ns,p999Ns,maxNs\n";
+    for (const Repr &r : reprs)
+        runRepr(r, maxThreads, base);
+    return 0;
+}
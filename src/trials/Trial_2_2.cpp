@@ -7,12 +7,17 @@
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <fstream>
+#include <string>
 
 #include "TraversalAlgo.hpp"
 #include "GraphGen.hpp"
+#include "LatencyHistogram.hpp"
 
 // Trial_2_2.cpp (Time measurement, BinaryTree, full permutations)
 // Added: Trial layer (repeat full-permutation measurement T times, then summarize across trials)
+// Added: per-traversal latency histogram (p50/p90/p99/p99.9), optional CSV output
+// Usage: Trial_2_2 [trials=10] [csvPath]
 
 struct TimeStats {
     std::size_t count = 0;
@@ -21,9 +26,11 @@ struct TimeStats {
     double sumNs = 0.0;
     std::size_t minIndex = 0;
     std::size_t maxIndex = 0;
+    LatencyHistogram hist; // per-permutation traversal time (ns)
 
     void add(double ns, std::size_t idx) {
         ++count;
+        hist.record(static_cast<std::uint64_t>(ns));
         sumNs += ns;
         if (ns < minNs) { minNs = ns; minIndex = idx; }
         if (ns > maxNs) { maxNs = ns; maxIndex = idx; }
@@ -160,13 +167,37 @@ static void printAcrossTrialsStats(const char* title,
     std::cout << "  min(overall) = " << globalMin
               << " ns (trial=" << minTrial << ", perm index=" << minPermIndex << ")\n";
     std::cout << "  max(overall) = " << globalMax
-              << " ns (trial=" << maxTrial << ", perm index=" << maxPermIndex << ")\n\n";
+              << " ns (trial=" << maxTrial << ", perm index=" << maxPermIndex << ")\n";
+
+    LatencyHistogram all;
+    for (const TimeStats& t : trials) all.merge(t.hist);
+    std::cout << "  p50/p90/p99/p99.9 = " << all.percentile(0.5) << " / " << all.percentile(0.9) << " / "
+              << all.percentile(0.99) << " / " << all.percentile(0.999) << " ns\n\n";
+}
+
+// CSV: one row per trial plus an "all" row merging every trial's histogram
+static void appendPercentileCsv(std::ofstream* csv, const char* caseName, const char* algo,
+                                const std::vector<TimeStats>& trials) {
+    if (csv == nullptr) return;
+    auto row = [&](const std::string& trial, const LatencyHistogram& h) {
+        *csv << '"' << caseName << "\"," << algo << ',' << trial << ',' << h.count() << ','
+             << h.min() << ',' << h.mean() << ',' << h.max() << ','
+             << h.percentile(0.5) << ',' << h.percentile(0.9) << ','
+             << h.percentile(0.99) << ',' << h.percentile(0.999) << '\n';
+    };
+    LatencyHistogram all;
+    for (std::size_t t = 0; t < trials.size(); ++t) {
+        row(std::to_string(t), trials[t].hist);
+        all.merge(trials[t].hist);
+    }
+    row("all", all);
 }
 
 template <typename G>
 static void runOneCaseTrials(const char* caseName,
                              const G& baseGraph,
-                             int trialsCount) {
+                             int trialsCount,
+                             std::ofstream* csv) {
     std::vector<TimeStats> bfsTrials;
     std::vector<TimeStats> dfsTrials;
     bfsTrials.reserve(trialsCount);
@@ -200,6 +231,8 @@ static void runOneCaseTrials(const char* caseName,
     std::cout << caseName << "\n";
     printAcrossTrialsStats("BFS time (across trials):", bfsTrials);
     printAcrossTrialsStats("DFS time (across trials):", dfsTrials);
+    appendPercentileCsv(csv, caseName, "BFS", bfsTrials);
+    appendPercentileCsv(csv, caseName, "DFS", dfsTrials);
 }
 
 int main(int argc, char** argv) {
@@ -209,6 +242,18 @@ int main(int argc, char** argv) {
         if (x > 0) trialsCount = x;
     }
 
+    std::ofstream csvFile;
+    std::ofstream* csv = nullptr;
+    if (argc >= 3) {
+        csvFile.open(argv[2]);
+        if (!csvFile.is_open()) {
+            std::cerr << "Failed to open csv file: " << argv[2] << "\n";
+            return 1;
+        }
+        csvFile << "case,algo,trial,count,minNs,avgNs,maxNs,p50Ns,p90Ns,p99Ns,p999Ns\n";
+        csv = &csvFile;
+    }
+
     std::cout << "===== Trial_2.2: Time measurement (BinaryTree, full permutations) =====\n";
     std::cout << "Trials per case = " << trialsCount << "\n\n";
 
@@ -218,10 +263,10 @@ int main(int argc, char** argv) {
         std::cout << "----- n = 8 (8! = 40320) -----\n\n";
 
         std::cout << "[AdjList]\n\n";
-        runOneCaseTrials("BinaryTree(8) [AdjList]", GraphGen::makeBinaryTreeAdjList(n), trialsCount);
+        runOneCaseTrials("BinaryTree(8) [AdjList]", GraphGen::makeBinaryTreeAdjList(n), trialsCount, csv);
 
         std::cout << "[AdjMatrix]\n\n";
-        runOneCaseTrials("BinaryTree(8) [AdjMatrix]", GraphGen::makeBinaryTreeAdjMatrix(n), trialsCount);
+        runOneCaseTrials("BinaryTree(8) [AdjMatrix]", GraphGen::makeBinaryTreeAdjMatrix(n), trialsCount, csv);
     }
 
     // n = 9
@@ -230,10 +275,10 @@ int main(int argc, char** argv) {
         std::cout << "----- n = 9 (9! = 362880) -----\n\n";
 
         std::cout << "[AdjList]\n\n";
-        runOneCaseTrials("BinaryTree(9) [AdjList]", GraphGen::makeBinaryTreeAdjList(n), trialsCount);
+        runOneCaseTrials("BinaryTree(9) [AdjList]", GraphGen::makeBinaryTreeAdjList(n), trialsCount, csv);
 
         std::cout << "[AdjMatrix]\n\n";
-        runOneCaseTrials("BinaryTree(9) [AdjMatrix]", GraphGen::makeBinaryTreeAdjMatrix(n), trialsCount);
+        runOneCaseTrials("BinaryTree(9) [AdjMatrix]", GraphGen::makeBinaryTreeAdjMatrix(n), trialsCount, csv);
     }
 
     return 0;
@@ -4,9 +4,20 @@
 #include "ReGraph.hpp"
 #include "MetricsResStorage.hpp"
 #include "Constants.hpp"
+#include <iostream>
+#include <stdexcept>
 
 int main() {
     using namespace std;
+    const string resPath = "./TrialRes/SpaceTrial/res.csv";
+    // 旧版本写出的结果文件（列数不同）在测量前就报错，而不是算完才在保存时失败
+    try {
+        Utility::checkResHeader(resPath);
+    } catch (const runtime_error& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
     AdjListGraph list_binary_tree = GraphGen::makeBinaryTreeAdjList(9);
     list_binary_tree.setLabel("List: Binary Tree");
 
@@ -52,7 +63,7 @@ int main() {
             MetricsResStorage entry = Utility::doSpaceMeasure(newGraph);
             res.merge(entry);
             if(res.getResGroupSize() >= FLUSH_CONTROL) {
-                Utility::saveRes("./TrialRes/SpaceTrial/res.csv", res);
+                Utility::saveRes(resPath, res);
                 res.clear();
             }
         }
@@ -66,14 +77,14 @@ int main() {
             MetricsResStorage entry = Utility::doSpaceMeasure(newGraph);
             res.merge(entry);
             if(res.getResGroupSize() >= FLUSH_CONTROL) {
-                Utility::saveRes("./TrialRes/SpaceTrial/res.csv", res);
+                Utility::saveRes(resPath, res);
                 res.clear();
             }
         }
     }
 
     if (res.getResGroupSize() > 0) {
-        Utility::saveRes("./TrialRes/SpaceTrial/res.csv", res);
+        Utility::saveRes(resPath, res);
         res.clear(); // 或 clear()
     }
     return 0;
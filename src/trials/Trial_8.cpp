@@ -6,9 +6,14 @@
 #include "ReGraph.hpp"
 #include "DistributionStorage.hpp"
 #include "Metrics.hpp"
+#include "MeasureCache.hpp"
 #include "Constants.hpp"
+#include "AllocProfile.hpp"
 #include "Construction.hpp"
+#include "Instrument.hpp"
+#include "Tracer.hpp"
 #include "RankSeeking.hpp"
+#include "TraversalCursor.hpp"
 
 #include <chrono>
 #include <iostream>
@@ -27,7 +32,7 @@ namespace
     }
 
     template <class G>
-    void doDFSSpaceMeasure(const G &graph, DistributionStorage &dist)
+    void doDFSSpaceMeasure(const G &graph, DistributionStorage &dist, MeasureCache &cache)
     {
         dist.clear();
         const int nodeCount = graph.getNodeCount();
@@ -41,10 +46,11 @@ namespace
         {
             while (reGrapher.next(res))
             {
+                const MeasureCache::Structure structure = cache.structureOf(res);
                 for (int root = 0; root < nodeCount; ++root)
                 {
                     vector<string> accessRank;
-                    const size_t space = Metrics::measureDFSMaxStackFromRoot(res, accessRank, root);
+                    const size_t space = cache.measure(res, structure, root, MeasureCache::Algo::DFS, accessRank);
                     dist.insert(accessRank, space);
                 }
             }
@@ -53,10 +59,11 @@ namespace
         {
             while (reGrapher.nextRandom(res))
             {
+                const MeasureCache::Structure structure = cache.structureOf(res);
                 for (int root = 0; root < nodeCount; ++root)
                 {
                     vector<string> accessRank;
-                    const size_t space = Metrics::measureDFSMaxStackFromRoot(res, accessRank, root);
+                    const size_t space = cache.measure(res, structure, root, MeasureCache::Algo::DFS, accessRank);
                     dist.insert(accessRank, space);
                 }
             }
@@ -64,7 +71,7 @@ namespace
     }
 
     template <class G>
-    void doBFSSpaceMeasure(const G &graph, DistributionStorage &dist)
+    void doBFSSpaceMeasure(const G &graph, DistributionStorage &dist, MeasureCache &cache)
     {
         dist.clear();
         const int nodeCount = graph.getNodeCount();
@@ -78,10 +85,11 @@ namespace
         {
             while (reGrapher.next(res))
             {
+                const MeasureCache::Structure structure = cache.structureOf(res);
                 for (int root = 0; root < nodeCount; ++root)
                 {
                     vector<string> accessRank;
-                    const size_t space = Metrics::measureBFSMaxQueueFromRoot(res, accessRank, root);
+                    const size_t space = cache.measure(res, structure, root, MeasureCache::Algo::BFS, accessRank);
                     dist.insert(accessRank, space);
                 }
             }
@@ -90,10 +98,11 @@ namespace
         {
             while (reGrapher.nextRandom(res))
             {
+                const MeasureCache::Structure structure = cache.structureOf(res);
                 for (int root = 0; root < nodeCount; ++root)
                 {
                     vector<string> accessRank;
-                    const size_t space = Metrics::measureBFSMaxQueueFromRoot(res, accessRank, root);
+                    const size_t space = cache.measure(res, structure, root, MeasureCache::Algo::BFS, accessRank);
                     dist.insert(accessRank, space);
                 }
             }
@@ -137,6 +146,28 @@ namespace
         return Metrics::measureBFSMaxQueueFromRoot(reorderedGraph, outOrder, root.index);
     }
 
+    // 用游标逐个比对遍历产出与 rank，遇到首个不一致立即停止；
+    // 完全一致时 space 为完整遍历的峰值，无需再物化 order
+    template <class Cursor, class G>
+    bool traversalMatchesRank(const G &reorderedGraph,
+                              const std::vector<std::string> &rank,
+                              size_t &space)
+    {
+        Node root = reorderedGraph.getNode(rank[0]);
+        Cursor cursor(reorderedGraph, root.index);
+
+        std::size_t i = 0;
+        Index v = -1;
+        while (cursor.next(v))
+        {
+            if (i >= rank.size() || reorderedGraph.getNode(v).label != rank[i])
+                return false;
+            ++i;
+        }
+        space = cursor.peak();
+        return i == rank.size();
+    }
+
     template <class G>
     void runOneCase(
         const size_t n,
@@ -147,6 +178,7 @@ namespace
         bool isDFS)
     {
         using Clock = std::chrono::steady_clock;
+        TRIAL_TRACE_SPAN("Trial_8", fileTag);
 
         const std::string tag =
             "[Trial_8]" + caseTag +
@@ -160,15 +192,23 @@ namespace
         // 1) General distribution
         DistributionStorage generalDist;
         {
+            TRIAL_PHASE(fileTag + "/general");
+            TRIAL_ALLOC_PHASE(fileTag + "/general");
+            TRIAL_TRACE_SPAN("Trial_8", "general distribution");
             std::cout << tag << "Collecting general distribution..." << std::endl;
             auto t0 = Clock::now();
 
+            MeasureCache cache;
             if (isDFS)
-                doDFSSpaceMeasure(g, generalDist);
+                doDFSSpaceMeasure(g, generalDist, cache);
             else
-                doBFSSpaceMeasure(g, generalDist);
+                doBFSSpaceMeasure(g, generalDist, cache);
 
             std::cout << tag << "General distribution collected. elapsed=" << msSince(t0) << "ms"
+                      << " cacheHits=" << cache.hits()
+                      << " cacheMisses=" << cache.misses()
+                      << " cacheBypassed=" << cache.bypassed()
+                      << " hitRate=" << cache.hitRate()
                       << std::endl;
 
             std::cout << tag << "Writing general CSVs..." << std::endl;
@@ -187,6 +227,9 @@ namespace
         // 2) RankSeeking ranks
         std::vector<std::vector<std::string>> ranksSought;
         {
+            TRIAL_PHASE(fileTag + "/rankSeeking");
+            TRIAL_ALLOC_PHASE(fileTag + "/rankSeeking");
+            TRIAL_TRACE_SPAN("Trial_8", "RankSeeking");
             std::cout << tag
                       << (isDFS ? "RankSeeking::getBestRanksForDFS..." : "RankSeeking::getBestRanksForBFS...")
                       << std::endl;
@@ -201,6 +244,9 @@ namespace
 
         // 3) Measure ranksSought and write optimal distribution
         {
+            TRIAL_PHASE(fileTag + "/measureRanks");
+            TRIAL_ALLOC_PHASE(fileTag + "/measureRanks");
+            TRIAL_TRACE_SPAN("Trial_8", "measure ranks");
             std::cout << tag << "Measuring ranksSought traversal space..." << std::endl;
             auto t0 = Clock::now();
 
@@ -228,29 +274,36 @@ namespace
                     continue;
                 }
 
-                std::vector<std::string> order;
                 size_t space = 0;
+                const bool matched = isDFS
+                                         ? traversalMatchesRank<PathDFSCursor>(reorderedGraph, rank, space)
+                                         : traversalMatchesRank<BFSCursor>(reorderedGraph, rank, space);
+                if (matched)
+                {
+                    optimalDist.insert(rank, space);
+                    continue;
+                }
+
+                // 不一致：重新完整测量一次，用于打印诊断信息并记录实际访问序
+                std::vector<std::string> order;
                 if (isDFS)
                     space = measureRankDFS(reorderedGraph, rank, order);
                 else
                     space = measureRankBFS(reorderedGraph, rank, order);
 
-                if (order != rank)
-                {
-                    ++mismatchCnt;
-                    std::cout << tag << "ERROR: rank != traversal order. rank_idx=" << i
-                              << " space=" << space << std::endl;
-
-                    std::cout << tag << "rank : ";
-                    for (auto &s : rank)
-                        std::cout << s << " ";
-                    std::cout << std::endl;
-
-                    std::cout << tag << "order: ";
-                    for (auto &s : order)
-                        std::cout << s << " ";
-                    std::cout << std::endl;
-                }
+                ++mismatchCnt;
+                std::cout << tag << "ERROR: rank != traversal order. rank_idx=" << i
+                          << " space=" << space << std::endl;
+
+                std::cout << tag << "rank : ";
+                for (auto &s : rank)
+                    std::cout << s << " ";
+                std::cout << std::endl;
+
+                std::cout << tag << "order: ";
+                for (auto &s : order)
+                    std::cout << s << " ";
+                std::cout << std::endl;
 
                 optimalDist.insert(order, space);
             }
@@ -281,6 +334,10 @@ int main(int argc, char **argv)
     const double p = std::stod(argv[2]);
     const std::string number = std::string(argv[3]);
 
+    // 阶段追踪：结束后写出 Chrome trace JSON（chrome://tracing 或 Perfetto UI 打开）
+    Tracer::setThreadName("main");
+    Tracer::start();
+
     // AdjListGraph
     runOneCase<AdjListGraph>(n, p, number, "[AdjList][DFS]", "AdjList_DFS", /*isDFS*/ true);
     runOneCase<AdjListGraph>(n, p, number, "[AdjList][BFS]", "AdjList_BFS", /*isDFS*/ false);
@@ -289,5 +346,20 @@ int main(int argc, char **argv)
     runOneCase<AdjMatrixGraph>(n, p, number, "[AdjMatrix][DFS]", "AdjMatrix_DFS", /*isDFS*/ true);
     runOneCase<AdjMatrixGraph>(n, p, number, "[AdjMatrix][BFS]", "AdjMatrix_BFS", /*isDFS*/ false);
 
+    Tracer::stop();
+    const std::string tracePath =
+        "./TrialRes/Trial_8/trace_" + std::to_string(n) + "_" + std::to_string(p) + "_" + number + ".json";
+    Tracer::writeJson(tracePath);
+    std::cout << "[Trial_8] Trace written: " << tracePath << " events=" << Tracer::eventCount()
+              << " dropped=" << Tracer::droppedCount() << std::endl;
+
+    // 热路径计数（-DTRIAL_INSTRUMENT=ON 时）：按阶段输出
+    std::cout << "[Trial_8] Instrumentation:" << std::endl;
+    Instrument::report(std::cout);
+
+    // 分配剖析（-DTRIAL_ALLOC_PROFILE=ON 时）：按阶段 × 调用点输出
+    std::cout << "[Trial_8] Allocation profile:" << std::endl;
+    AllocProfile::report(std::cout);
+
     return 0;
 }
\ No newline at end of file